@@ -26,6 +26,8 @@
 #ifndef __LIVE_SEQUENCE_FITTING_H__
 #define __LIVE_SEQUENCE_FITTING_H__
 
+#include <vector>
+
 #include "mesh/Mesh.h"
 
 #include "optimization/fitmodel/EnergyData.h"
@@ -43,9 +45,12 @@ public:
 
   LiveSequenceFitting(
     const Model& model,
+    const std::vector<int>& sourceIds,
     const Settings& settings) :
     energyData(model), settings(settings) {
 
+    // only the model vertices corresponding to the received points are used
+    this->energyData.sourceIds = sourceIds;
 
     this->energy = new fitModel::Energy(this->energyData,
                                         this->settings.energySettings);
@@ -59,6 +64,36 @@ public:
 
   /*--------------------------------------------------------------------------*/
 
+  ~LiveSequenceFitting() {
+
+    delete this->energyMinimizer;
+    delete this->energy;
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  LiveSequenceFitting(const LiveSequenceFitting&) = delete;
+  LiveSequenceFitting& operator=(const LiveSequenceFitting&) = delete;
+
+  /*--------------------------------------------------------------------------*/
+
+  /* applies new settings while keeping the current weights and the state of
+   * the minimizer
+   */
+  void update_settings(const Settings& settings) {
+
+    this->settings = settings;
+
+    // the energy keeps its own copy of the energy settings
+    this->energy->settings() = this->settings.energySettings;
+
+    this->energyMinimizer->update_settings();
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
   const arma::vec& get_speaker_weights() const {
       return this->energyData.speakerWeights;
   }
@@ -97,22 +132,22 @@ private:
   void fit_first_frame() {
 
     const double speakerSmoothnessWeight =
-      this->settings.energySettings.weights.at("speakerSmoothnessTerm");
+      this->settings.energySettings.weights.speakerSmoothnessTerm;
 
     const double phonemeSmoothnessWeight =
-      this->settings.energySettings.weights.at("phonemeSmoothnessTerm");
+      this->settings.energySettings.weights.phonemeSmoothnessTerm;
 
     // set weights to 0 for first frame
-    this->settings.energySettings.weights.at("speakerSmoothnessTerm") = 0;
-    this->settings.energySettings.weights.at("phonemeSmoothnessTerm") = 0;
+    this->settings.energySettings.weights.speakerSmoothnessTerm = 0;
+    this->settings.energySettings.weights.phonemeSmoothnessTerm = 0;
 
     fit_frame();
 
     // restore old weights
-    this->settings.energySettings.weights.at("speakerSmoothnessTerm") =
+    this->settings.energySettings.weights.speakerSmoothnessTerm =
       speakerSmoothnessWeight;
 
-    this->settings.energySettings.weights.at("phonemeSmoothnessTerm") =
+    this->settings.energySettings.weights.phonemeSmoothnessTerm =
       phonemeSmoothnessWeight;
 
     this->firstFrame = false;
@@ -45,10 +45,10 @@ public:
     fitModel::EnergySettings& energySettings =
       this->tracker.data().settings.energySettings;
 
-    energySettings.weights["speakerSmoothnessTerm"] =
+    energySettings.weights.speakerSmoothnessTerm =
       action["speakerSmoothnessTerm"].as<double>();
 
-    energySettings.weights["phonemeSmoothnessTerm"] =
+    energySettings.weights.phonemeSmoothnessTerm =
       action["phonemeSmoothnessTerm"].as<double>();
 
     this->tracker.data().settings.minimizerSettings.priorSize =
@@ -47,7 +47,7 @@ public:
   // original multilinear model
   Model originalModel;
 
-  // current model (might be truncated)
+  // current model (might be a pca model with fixed speaker)
   Model currentModel;
 
   // current target data
@@ -61,12 +61,11 @@ public:
 
   void init() {
 
-    if( this->fitting != nullptr) {
-      delete this->fitting;
-    }
+    clear();
 
     fitting = new LiveSequenceFitting(
       this->trackerData.currentModel,
+      this->trackerData.sourceIds,
       this->trackerData.settings
       );
 
@@ -74,9 +73,38 @@ public:
 
   /*--------------------------------------------------------------------------*/
 
+  /* the fitting refers to the current model, it has to be cleared before
+   * the model is replaced
+   */
+  void clear() {
+
+    if( this->fitting != nullptr) {
+      delete this->fitting;
+    }
+
+    this->fitting = nullptr;
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  void update_settings() {
+
+    // settings are picked up by the next init()
+    if( this->fitting == nullptr) {
+      return;
+    }
+
+    this->fitting->update_settings(this->trackerData.settings);
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
   void apply() {
 
-    if( this->trackerState.sourceIdsSet == false) {
+    if( this->trackerState.sourceIdsSet == false ||
+        this->fitting == nullptr ) {
       throw std::runtime_error("Source indices not set!");
     }
 
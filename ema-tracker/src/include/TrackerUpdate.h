@@ -51,8 +51,8 @@ public:
 
   void for_settings() {
 
-    // reinitialize fitting object
-    this->trackerFitting.init();
+    // keep the fitting object, the fit continues from the current weights
+    this->trackerFitting.update_settings();
 
   }
 
@@ -60,25 +60,8 @@ public:
 
   void for_source_ids() {
 
-    // create copy of model
-    this->trackerData.currentModel =
-      this->trackerData.originalModel;
-
-    // generate list of entry indices
-    std::set<int> vertexIndices;
-
-    for(const int& id: this->trackerData.sourceIds) {
-
-      for(int i = 0; i < 3; ++i) {
-        vertexIndices.insert(3 * id + i);
-      }
-
-    }
-
-    // truncate the model
-    this->trackerData.currentModel.truncate().vertex(vertexIndices);
-
-    // initialize fitting object
+    // initialize fitting object, the energy only reconstructs the
+    // model vertices belonging to the source ids
     this->trackerFitting.init();
 
     this->trackerState.sourceIdsSet = true;
@@ -89,6 +72,9 @@ public:
 
   void reset() {
 
+    // the fitting refers to the model that is replaced
+    this->trackerFitting.clear();
+
     this->trackerData.currentModel = this->trackerData.originalModel;
     this->trackerData.speakerWeights.clear();
     this->trackerState.sourceIdsSet = false;
@@ -115,7 +101,8 @@ public:
       std::cerr << "speaker already fixed." << std::endl;
     }
 
-    // construct pca model
+    // construct pca model, the fitting refers to the model that is replaced
+    this->trackerFitting.clear();
     set_pca_model();
 
     this->trackerFitting.init();
@@ -37,12 +37,10 @@ namespace YAML {
     static Node encode(const Mesh& rhs) {
       Node node;
 
-      const std::vector<arma::vec> vertices = rhs.get_vertices();
+      const PointList& vertices = rhs.get_vertices();
 
-      for(const arma::vec& vertex : vertices) {
-        node.push_back(vertex(0));
-        node.push_back(vertex(1));
-        node.push_back(vertex(2));
+      for(size_t i = 0; i < 3 * vertices.size(); ++i) {
+        node.push_back(vertices.data()[i]);
       }
 
       return node;
@@ -54,16 +52,16 @@ namespace YAML {
         return false;
       }
 
-      std::vector<arma::vec> vertices;
+      PointList vertices;
+      vertices.reserve(node.size() / 3);
 
       for(unsigned int i = 0; i < node.size() / 3; ++i) {
 
-        arma::vec vertex({ node[3 * i + 0].as<double>(),
-              node[3 * i + 1].as<double>(),
-              node[3 * i + 2].as<double>()
-              });
-
-        vertices.push_back(vertex);
+        vertices.push_back(
+          node[3 * i + 0].as<double>(),
+          node[3 * i + 1].as<double>(),
+          node[3 * i + 2].as<double>()
+          );
 
       }
 
@@ -118,13 +118,16 @@ public:
     // we are not using nearest neighbor discovery -> use only one iteration
     this->minimizerSettings.iterationAmount = 1;
 
+    // consecutive frames are similar -> keep the minimizer state
+    this->minimizerSettings.warmStart = true;
+
     // use fixed correspondences
     this->energySettings.searchStrategy =
       fitModel::EnergySettings::SearchStrategy::FIXED;
 
     // set weights
-    this->energySettings.weights["speakerSmoothnessTerm"] = speakerWeight;
-    this->energySettings.weights["phonemeSmoothnessTerm"] = phonemeWeight;
+    this->energySettings.weights.speakerSmoothnessTerm = speakerWeight;
+    this->energySettings.weights.phonemeSmoothnessTerm = phonemeWeight;
 
   }
 
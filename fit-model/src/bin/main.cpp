@@ -23,9 +23,19 @@
    along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 ****/
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <iostream>
+#include <exception>
+#include <algorithm>
+
 #include <armadillo>
 
 #include "settings.h"
+#include "FitManifest.h"
 
 #include "landmark/LandmarkIO.h"
 
@@ -38,14 +48,13 @@
 #include "optimization/fitmodel/EnergyMinimizer.h"
 #include "optimization/MinimizerSettings.h"
 
-int main(int argc, char* argv[]) {
-
-  Settings settings(argc, argv);
+/* fits the model to the target of the job and writes the result,
+ * the model is only read, the settings are a private copy
+ */
+void fit_target(const Model& model, Settings settings, const FitJob& job) {
 
   // read input data
-  Mesh target = MeshIO::read(settings.target);
-  ModelReader reader(settings.model);
-  Model model = reader.get_model();
+  Mesh target = MeshIO::read(job.target);
 
   // deal with target meshes that do not provide normals
   if( settings.fixedNeighbors == false && target.has_normals() == false ) {
@@ -53,6 +62,7 @@ int main(int argc, char* argv[]) {
     // try to estimate normals if the mesh has faces
     if( target.has_faces() == true ) {
       NormalEstimation estimation(target);
+      estimation.set_thread_amount(settings.energySettings.threadAmount);
       target.set_vertex_normals(estimation.compute());
     } // end if
     else {
@@ -65,8 +75,8 @@ int main(int argc, char* argv[]) {
 
   fitModel::EnergyData data(model, target);
 
-  if(settings.landmarksPresent == true) {
-    data.landmarks = LandmarkIO::read(settings.landmarks);
+  if(job.landmarks.empty() == false) {
+    data.landmarks = LandmarkIO::read(job.landmarks);
 
     // use landmarks only for initialization if wanted
     if(settings.useLandmarksOnlyForInitialization == true) {
@@ -92,8 +102,8 @@ int main(int argc, char* argv[]) {
   } // end if landmarksPresent
 
   // configure for fitting only
-  settings.energySettings.weights["dataTerm"] = 1;
-  settings.energySettings.weights["landmarkTerm"] = 1;
+  settings.energySettings.weights.dataTerm = 1;
+  settings.energySettings.weights.landmarkTerm = 1;
 
   fitModel::Energy energy(data, settings.energySettings);
 
@@ -101,7 +111,110 @@ int main(int argc, char* argv[]) {
 
   minimizer.minimize();
 
-  MeshIO::write(energy.derived_data().source, settings.output);
+  MeshIO::write(energy.derived_data().source, job.output);
+
+}
+
+/*----------------------------------------------------------------------------*/
+
+/* fits all targets of the batch file with a pool of workers sharing the
+ * model, results are written as soon as they are available
+ *
+ * returns the amount of targets that could not be fitted
+ */
+int fit_batch(const Model& model, const Settings& settings) {
+
+  const std::vector<FitJob> jobs =
+    FitManifest::read(settings.batch, settings.output);
+
+  const int jobAmount = jobs.size();
+  const int workerAmount =
+    std::max(1, std::min(settings.jobAmount, jobAmount));
+
+  std::atomic<int> next(0);
+  std::atomic<int> failures(0);
+  int finished = 0;
+
+  std::mutex outputMutex;
+
+  auto work = [&]() {
+
+    for(int i = next++; i < jobAmount; i = next++) {
+
+      const FitJob& job = jobs.at(i);
+      std::string error;
+
+      try {
+        fit_target(model, settings, job);
+      }
+      catch(const std::exception& exception) {
+        error = exception.what();
+        ++failures;
+      }
+      catch(...) {
+        error = "unknown error";
+        ++failures;
+      }
+
+      std::lock_guard<std::mutex> lock(outputMutex);
+
+      ++finished;
+
+      if( error.empty() == true ) {
+        std::cout << "[" << finished << "/" << jobAmount << "] "
+                  << job.target << " -> " << job.output << std::endl;
+      }
+      else {
+        std::cerr << "[" << finished << "/" << jobAmount << "] "
+                  << "Fitting " << job.target << " failed: " << error
+                  << std::endl;
+      }
+
+    }
+
+  };
+
+  std::vector<std::thread> workers;
+
+  for(int i = 1; i < workerAmount; ++i) {
+    workers.push_back(std::thread(work));
+  }
+
+  // the calling thread is a worker as well
+  work();
+
+  for(std::thread& worker: workers) {
+    worker.join();
+  }
+
+  return failures;
+
+}
+
+/*----------------------------------------------------------------------------*/
+
+int main(int argc, char* argv[]) {
+
+  Settings settings(argc, argv);
+
+  // the model is read once and shared by all fits
+  ModelReader reader(settings.model);
+  Model model = reader.get_model();
+
+  if( settings.batchPresent == true ) {
+    return ( fit_batch(model, settings) == 0 )? 0: 1;
+  }
+
+  FitJob job;
+
+  job.target = settings.target;
+  job.output = settings.output;
+
+  if( settings.landmarksPresent == true ) {
+    job.landmarks = settings.landmarks;
+  }
+
+  fit_target(model, settings, job);
 
   return 0;
 
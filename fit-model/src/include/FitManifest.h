@@ -0,0 +1,180 @@
+/****
+   This file is part of the multilinear-model-tools.
+   These tools are meant to derive a multilinear tongue model or
+   PCA palate model from mesh data and work with it.
+
+   Some code of the multilinear-model-tools is based on
+   Timo Bolkart's work on statistical analysis of human face shapes,
+   cf. https://sites.google.com/site/bolkartt/
+
+   Copyright (C) 2016 Alexander Hewer
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+****/
+#ifndef __FIT_MANIFEST_H__
+#define __FIT_MANIFEST_H__
+
+#include <string>
+#include <vector>
+#include <set>
+#include <stdexcept>
+
+#include <cerrno>
+#include <sys/stat.h>
+
+#include <yaml-cpp/yaml.h>
+
+/* target mesh that is fitted in batch mode */
+class FitJob {
+
+public:
+
+  std::string target;
+  std::string output;
+
+  // empty if no landmarks are used
+  std::string landmarks;
+
+};
+
+/* reads the targets of a batch fit from a YAML file of the form
+ *
+ * targets:
+ *   - target: path/to/mesh.ply
+ *     landmarks: path/to/landmarks.json  # optional
+ *     output: fitted.ply                 # optional, defaults to the mesh name
+ *
+ * output files are placed in the given output directory, missing
+ * directories are created, every output file may only be used once
+ */
+class FitManifest {
+
+public:
+
+  /*--------------------------------------------------------------------------*/
+
+  static std::vector<FitJob> read(
+    const std::string& fileName,
+    const std::string& outputDirectory
+    ) {
+
+    YAML::Node manifest = YAML::LoadFile(fileName);
+    YAML::Node targets = manifest["targets"];
+
+    if( targets.IsSequence() == false ) {
+      throw std::runtime_error("Manifest does not contain a list of targets.");
+    }
+
+    std::vector<FitJob> jobs;
+    std::set<std::string> outputs;
+
+    for(const YAML::Node& entry: targets) {
+
+      if( !entry["target"] ) {
+        throw std::runtime_error("Manifest entry without target mesh.");
+      }
+
+      FitJob job;
+
+      job.target = entry["target"].as<std::string>();
+
+      const std::string output = ( entry["output"] )?
+        entry["output"].as<std::string>() : file_name_of(job.target);
+
+      job.output = outputDirectory + "/" + output;
+
+      // concurrent workers would write the same file
+      if( outputs.insert(job.output).second == false ) {
+        throw std::runtime_error(
+          "Manifest uses output " + job.output + " more than once, " +
+          "set the output of the entry with target " + job.target + ".");
+      }
+
+      create_directories(directory_of(job.output));
+
+      if( entry["landmarks"] ) {
+        job.landmarks = entry["landmarks"].as<std::string>();
+      }
+
+      jobs.push_back(job);
+
+    }
+
+    return jobs;
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+private:
+
+  /*--------------------------------------------------------------------------*/
+
+  static std::string directory_of(const std::string& path) {
+
+    const size_t separator = path.find_last_of('/');
+
+    if( separator == std::string::npos ) {
+      return ".";
+    }
+
+    return ( separator == 0 )? "/" : path.substr(0, separator);
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  // creates the directory and all missing parents
+  static void create_directories(const std::string& path) {
+
+    size_t separator = 0;
+
+    do {
+
+      separator = path.find('/', separator + 1);
+
+      const std::string directory = path.substr(0, separator);
+
+      if( mkdir(directory.c_str(), 0755) != 0 && errno != EEXIST ) {
+        throw std::runtime_error(
+          "Could not create output directory " + directory + ".");
+      }
+
+    } while( separator != std::string::npos );
+
+    struct stat status;
+
+    if( stat(path.c_str(), &status) != 0 || S_ISDIR(status.st_mode) == 0 ) {
+      throw std::runtime_error(path + " is not a directory.");
+    }
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  static std::string file_name_of(const std::string& path) {
+
+    const size_t separator = path.find_last_of('/');
+
+    return ( separator == std::string::npos )?
+      path : path.substr(separator + 1);
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+};
+
+#endif
@@ -34,6 +34,7 @@
 #include "optimization/MinimizerSettings.h"
 
 #include <string>
+#include <stdexcept>
 
 class Settings {
 
@@ -45,10 +46,19 @@ public:
   std::string output;
   std::string landmarks;
 
+  // YAML list of targets that are fitted in one run,
+  // output is the output directory in this case
+  std::string batch;
+  bool batchPresent = false;
+
+  // amount of targets that are fitted concurrently in batch mode
+  int jobAmount = 1;
+
   MinimizerSettings minimizerSettings;
   fitModel::EnergySettings energySettings;
 
   bool fixedNeighbors = false;
+  bool matchSurface = false;
   bool useNoProjection = false;
   bool landmarksPresent = false;
   bool useLandmarksOnlyForInitialization = false;
@@ -56,10 +66,12 @@ public:
   Settings(int argc, char* argv[]) {
 
     // input and output
-    FlagSingle<std::string> targetFlag("target", this->target);
+    FlagSingle<std::string> targetFlag("target", this->target, true);
     FlagSingle<std::string> modelFlag("model", this->model);
     FlagSingle<std::string> outputFlag("output", this->output);
     FlagSingle<std::string> landmarksFlag("landmarks", this->landmarks, true);
+    FlagSingle<std::string> batchFlag("batch", this->batch, true);
+    FlagSingle<int> jobAmountFlag("jobs", this->jobAmount, true);
 
     /////////////////////////////////////////////////////////////////////////
 
@@ -95,7 +107,11 @@ public:
     FlagSingle<double> searchRadiusFlag(
       "searchRadius", this->energySettings.searchRadius, true);
 
+    FlagSingle<int> threadAmountFlag(
+      "threads", this->energySettings.threadAmount, true);
+
     FlagNone fixedNeighborsFlag("fixedNeighbors", this->fixedNeighbors);
+    FlagNone matchSurfaceFlag("matchSurface", this->matchSurface);
     FlagNone useNoProjectionFlag("useNoProjection", this->useNoProjection);
     FlagNone useLandmarksOnlyForInitializationFlag(
       "useLandmarksOnlyForInitialization",
@@ -110,6 +126,8 @@ public:
     parser.define_flag(&modelFlag);
     parser.define_flag(&outputFlag);
     parser.define_flag(&landmarksFlag);
+    parser.define_flag(&batchFlag);
+    parser.define_flag(&jobAmountFlag);
 
     // minimizer settings
     parser.define_flag(&useLandmarksOnlyForInitializationFlag);
@@ -123,7 +141,9 @@ public:
     parser.define_flag(&maxDistanceFlag);
     parser.define_flag(&maxAngleFlag);
     parser.define_flag(&searchRadiusFlag);
+    parser.define_flag(&threadAmountFlag);
     parser.define_flag(&fixedNeighborsFlag);
+    parser.define_flag(&matchSurfaceFlag);
     parser.define_flag(&useNoProjectionFlag);
 
     parser.parse_from_command_line(argc, argv);
@@ -134,12 +154,21 @@ public:
       this->energySettings.searchStrategy =
         fitModel::EnergySettings::SearchStrategy::FIXED;
     }
+    else if( this->matchSurface == true ) {
+      this->energySettings.searchStrategy =
+        fitModel::EnergySettings::SearchStrategy::SURFACE;
+    }
     else if( searchRadiusFlag.is_present() == true ) {
       this->energySettings.searchStrategy =
         fitModel::EnergySettings::SearchStrategy::ADAPTIVE;
     }
 
     this->landmarksPresent = landmarksFlag.is_present();
+    this->batchPresent = batchFlag.is_present();
+
+    if( this->batchPresent == false && targetFlag.is_present() == false ) {
+      throw std::runtime_error("Either a target or a batch file is required.");
+    }
 
   }
 
@@ -34,15 +34,17 @@
 
 #include "model/Model.h"
 #include "model/ModelBuilder.h"
+#include "model/StreamingModelBuilder.h"
 #include "model/ModelWriter.h"
 
 #include "settings.h"
 
-int main(int argc, char* argv[]){
+/*---------------------------------------------------------------------------*/
 
-  Settings settings(argc, argv);
+Model build_in_memory(const Settings& settings) {
 
-  SampleDataBase database = SampleFileReader::read_from(settings.samples);
+  SampleDataBase database = SampleFileReader::read_from(
+    settings.samples, settings.threadAmount, settings.progress);
   TrainingDataBuilder trainingBuilder(database);
 
   TrainingData data = trainingBuilder.build();
@@ -54,6 +56,7 @@ int main(int argc, char* argv[]){
   builder.set_faces(database.get_faces());
   builder.set_tensor(tensor);
   builder.set_origin(data.mean);
+  builder.set_decomposition_method(settings.decompositionMethod);
 
   if( settings.truncateSpeaker ) {
     builder.set_truncated_speaker_mode_dimension(settings.truncatedSpeakerDimension);
@@ -63,9 +66,44 @@ int main(int argc, char* argv[]){
     builder.set_truncated_phoneme_mode_dimension(settings.truncatedPhonemeDimension);
   }
 
-  Model model = builder.build();
+  return builder.build();
+
+}
+
+/*---------------------------------------------------------------------------*/
+
+Model build_streaming(const Settings& settings) {
+
+  StreamingModelBuilder builder;
+
+  builder.set_samples(settings.samples);
+
+  if( settings.spill ) {
+    builder.set_spill_file(settings.spillFile);
+  }
+
+  if( settings.truncateSpeaker ) {
+    builder.set_truncated_speaker_mode_dimension(settings.truncatedSpeakerDimension);
+  }
+
+  if( settings.truncatePhoneme ) {
+    builder.set_truncated_phoneme_mode_dimension(settings.truncatedPhonemeDimension);
+  }
+
+  return builder.build();
+
+}
+
+/*---------------------------------------------------------------------------*/
+
+int main(int argc, char* argv[]){
+
+  Settings settings(argc, argv);
+
+  Model model = ( settings.streaming ) ?
+    build_streaming(settings) : build_in_memory(settings);
 
-  ModelWriter writer(model);
+  ModelWriter writer(model, settings.outputFormat);
   writer.write(settings.output);
 
   if( settings.outputMeanMesh ) {
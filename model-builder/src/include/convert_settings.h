@@ -0,0 +1,68 @@
+/****
+   This file is part of the multilinear-model-tools.
+   These tools are meant to derive a multilinear tongue model or
+   PCA palate model from mesh data and work with it.
+
+   Some code of the multilinear-model-tools is based on
+   Timo Bolkart's work on statistical analysis of human face shapes,
+   cf. https://sites.google.com/site/bolkartt/
+
+   Copyright (C) 2016 Alexander Hewer
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+****/
+#ifndef __CONVERT_SETTINGS_H__
+#define __CONVERT_SETTINGS_H__
+
+#include "flags/FlagSingle.h"
+#include "flags/FlagsParser.h"
+
+#include <string>
+
+#include "model/ModelWriter.h"
+
+class ConvertSettings {
+
+public:
+
+  // input and output
+  std::string input;
+  std::string output;
+
+  // format of the written model
+  std::string format = "binary";
+  ModelWriter::Format outputFormat = ModelWriter::Format::BINARY;
+
+  ConvertSettings(int argc, char* argv[]) {
+
+    FlagSingle<std::string> inputFlag("input", this->input);
+    FlagSingle<std::string> outputFlag("output", this->output);
+    FlagSingle<std::string> formatFlag("format", this->format, true);
+
+    FlagsParser parser(argv[0]);
+
+    parser.define_flag(&inputFlag);
+    parser.define_flag(&outputFlag);
+    parser.define_flag(&formatFlag);
+
+    parser.parse_from_command_line(argc, argv);
+
+    this->outputFormat = ModelWriter::format_from_name(this->format);
+
+  }
+
+};
+
+#endif
@@ -28,8 +28,13 @@
 
 #include "flags/FlagSingle.h"
 #include "flags/FlagsParser.h"
+#include "flags/FlagNone.h"
 
 #include <string>
+#include <stdexcept>
+
+#include "tensor/TensorAnalysis.h"
+#include "model/ModelWriter.h"
 
 class Settings {
 
@@ -48,6 +53,28 @@ public:
 
   bool outputMeanMesh = false;
 
+  // amount of threads used for reading the training meshes
+  int threadAmount = 1;
+
+  // report the reading time of every training mesh
+  bool progress = false;
+
+  // stream meshes instead of loading the whole corpus into memory
+  bool streaming = false;
+
+  // optional memory mapped file holding the training data while streaming
+  std::string spillFile;
+  bool spill = false;
+
+  // format of the written model
+  std::string format = "yaml";
+  ModelWriter::Format outputFormat = ModelWriter::Format::TEXT;
+
+  // method used for computing the left singular vectors
+  std::string decomposition = "svd";
+  TensorAnalysis::DecompositionMethod decompositionMethod =
+    TensorAnalysis::DecompositionMethod::SVD;
+
   Settings(int argc, char* argv[]) {
 
 
@@ -64,22 +91,60 @@ public:
                                          this->truncatedPhonemeDimension,
                                          true);
 
+    FlagSingle<std::string> decompositionFlag("decomposition",
+                                              this->decomposition,
+                                              true);
+
+    FlagSingle<std::string> formatFlag("format", this->format, true);
+
+    FlagSingle<int> threadAmountFlag("threads", this->threadAmount, true);
+    FlagNone progressFlag("progress", this->progress);
+
+    FlagNone streamingFlag("streaming", this->streaming);
+    FlagSingle<std::string> spillFlag("spill", this->spillFile, true);
+
     FlagsParser parser(argv[0]);
 
     // input and output
     parser.define_flag(&samplesFlag);
     parser.define_flag(&outputFlag);
     parser.define_flag(&outputMeanMeshFlag);
+    parser.define_flag(&formatFlag);
 
     parser.define_flag(&truncatedSpeakerFlag);
     parser.define_flag(&truncatedPhonemeFlag);
 
+    parser.define_flag(&decompositionFlag);
+
+    parser.define_flag(&threadAmountFlag);
+    parser.define_flag(&progressFlag);
+
+    parser.define_flag(&streamingFlag);
+    parser.define_flag(&spillFlag);
+
     parser.parse_from_command_line(argc, argv);
 
     this->truncateSpeaker = truncatedSpeakerFlag.is_present();
     this->truncatePhoneme = truncatedPhonemeFlag.is_present();
     this->outputMeanMesh = outputMeanMeshFlag.is_present();
 
+    // spilling is only available while streaming
+    this->spill = spillFlag.is_present();
+    this->streaming = this->streaming || this->spill;
+
+    this->outputFormat = ModelWriter::format_from_name(this->format);
+
+    if( this->decomposition == "svd" ) {
+      this->decompositionMethod = TensorAnalysis::DecompositionMethod::SVD;
+    }
+    else if( this->decomposition == "gram" ) {
+      this->decompositionMethod = TensorAnalysis::DecompositionMethod::GRAM;
+    }
+    else {
+      throw std::runtime_error(
+        "Unknown decomposition method: " + this->decomposition + ".");
+    }
+
   }
 
 };
@@ -29,48 +29,59 @@
 #include <vector>
 #include <armadillo>
 
-#include <ANN/ANN.h>
+#include "mesh/PointList.h"
+#include "alignment/SpatialTree.h"
 
+/* nearest neighbor search in a point set based on SpatialTree,
+ * queries are thread-safe
+ */
 class KdTree{
 
   public:
 
     /*----------------------------------------------------------------------------*/
 
-    KdTree() {
-      this->kdTree = nullptr;
-    }
+    /* caller owned scratch space for queries
+     *
+     * the buffers only grow, hence reusing one query object for consecutive
+     * searches avoids heap allocations once the largest result was seen
+     */
+    class Query{
 
-    /*----------------------------------------------------------------------------*/
+      public:
 
-    KdTree(
-        const std::vector<arma::vec>& points
-        ) {
+        /* indices and squared distances of the points found by the
+         * last search
+         */
+        std::vector<int> indices;
+        std::vector<double> squaredDistances;
 
-      this->dataPts = annAllocPts(points.size(), 3);
+    };
 
-      for( size_t index = 0; index < points.size(); ++index) {
+    /*----------------------------------------------------------------------------*/
 
-        this->dataPts[index][0] = points.at(index)(0);
-        this->dataPts[index][1] = points.at(index)(1);
-        this->dataPts[index][2] = points.at(index)(2);
+    KdTree() {
+    }
 
+    /*----------------------------------------------------------------------------*/
 
-      }
+    KdTree(
+        const PointList& points
+        ) {
 
-      this->kdTree = new ANNkd_tree(this->dataPts, points.size(), 3);
-      this->points = points;
+      this->tree.build_points(points);
 
     }
 
     /*----------------------------------------------------------------------------*/
 
-    ~KdTree() {
-      if( this->kdTree != nullptr ) {
-        annDeallocPts(dataPts);
-        delete kdTree;
-        this->kdTree = nullptr;
-      }
+    /* updates the point coordinates in place if the amount of points did not
+     * change, returns false otherwise
+     */
+    bool refit(const PointList& points) {
+
+      return this->tree.refit_points(points);
+
     }
 
     /*----------------------------------------------------------------------------*/
@@ -78,71 +89,87 @@ class KdTree{
     arma::vec get_nearest_neighbor(const arma::vec& point) const {
 
       const int index = get_nearest_neighbor_index(point);
-      return this->points.at(index);
+
+      arma::vec result(3);
+      this->tree.get_point(index, result.memptr());
+
+      return result;
     }
     /*----------------------------------------------------------------------------*/
 
     int get_nearest_neighbor_index(const arma::vec& point) const {
 
-      ANNpoint queryPt;
-      ANNidxArray nnIdx;
-      ANNdistArray dists;
+      double squaredDistance;
+
+      return get_nearest_neighbor_index(point, squaredDistance);
+
+    }
+
+    /*----------------------------------------------------------------------------*/
+
+    /* version of get_nearest_neighbor_index() that also provides the squared
+     * distance to the found point, does not allocate any memory
+     */
+    int get_nearest_neighbor_index(
+      const arma::vec& point,
+      double& squaredDistance) const {
 
-      queryPt = annAllocPt(3);
-      nnIdx = new ANNidx[1];
-      dists = new ANNdist[1];
+      return this->tree.nearest(point.memptr(), squaredDistance);
 
-      nnIdx[0] = -1;
+    }
 
-      queryPt[0] = point(0);
-      queryPt[1] = point(1);
-      queryPt[2] = point(2);
+    /*----------------------------------------------------------------------------*/
 
-      kdTree->annkPriSearch(queryPt, 1, nnIdx, dists);
+    /* nearest neighbor search for a whole point array,
+     * entry i of the results belongs to points[i]
+     */
+    void get_nearest_neighbor_indices(
+      const PointList& points,
+      std::vector<int>& indices,
+      std::vector<double>& squaredDistances) const {
 
-      const int index = nnIdx[0];
+      indices.resize(points.size());
+      squaredDistances.resize(points.size());
 
-      annDeallocPt(queryPt);
-      delete [] nnIdx;
-      delete [] dists;
+      const double* coordinates = points.data();
 
-      return index;
+      for(size_t i = 0; i < points.size(); ++i) {
+        indices[i] = this->tree.nearest(coordinates + 3 * i, squaredDistances[i]);
+      }
 
     }
 
     /*----------------------------------------------------------------------------*/
 
-    std::vector<arma::vec> get_nearest_neighbors(
+    /* finds the k nearest neighbors sorted by increasing distance */
+    void get_k_nearest_neighbors_index(
       const arma::vec& point,
-      const double radius) const {
+      const int& k,
+      Query& query) const {
 
-      ANNpoint queryPt;
-      ANNidxArray nnIdx;
-      ANNdistArray dists;
+      this->tree.k_nearest(
+        point.memptr(), k, query.indices, query.squaredDistances);
 
-      queryPt = annAllocPt(3);
+    }
 
-      queryPt[0] = point(0);
-      queryPt[1] = point(1);
-      queryPt[2] = point(2);
+    /*----------------------------------------------------------------------------*/
 
-      unsigned int k = kdTree->annkFRSearch(queryPt, radius, 0, NULL, NULL);
+    std::vector<arma::vec> get_nearest_neighbors(
+      const arma::vec& point,
+      const double radius) const {
 
-      nnIdx = new ANNidx[k];
-      dists = new ANNdist[k];
+      Query query;
 
-      kdTree->annkFRSearch(queryPt, radius, k, nnIdx, dists);
+      get_nearest_neighbors_index(point, radius, query);
 
       std::vector<arma::vec> result;
 
-      for(size_t i = 0; i < k; ++i) {
-        result.push_back(this->points.at(nnIdx[i]));
+      for(const int& index: query.indices) {
+        arma::vec neighbor(3);
+        this->tree.get_point(index, neighbor.memptr());
+        result.push_back(neighbor);
       }
 
-      annDeallocPt(queryPt);
-      delete [] nnIdx;
-      delete [] dists;
-
       return result;
 
     }
@@ -153,34 +180,29 @@ class KdTree{
       const arma::vec& point,
       const double radius) const {
 
-      ANNpoint queryPt;
-      ANNidxArray nnIdx;
-      ANNdistArray dists;
-
-      queryPt = annAllocPt(3);
-
-      queryPt[0] = point(0);
-      queryPt[1] = point(1);
-      queryPt[2] = point(2);
-
-      unsigned int k = kdTree->annkFRSearch(queryPt, radius, 0, NULL, NULL);
+      Query query;
 
-      nnIdx = new ANNidx[k];
-      dists = new ANNdist[k];
+      get_nearest_neighbors_index(point, radius, query);
 
-      kdTree->annkFRSearch(queryPt, radius, k, nnIdx, dists);
+      return query.indices;
 
-      std::vector<int> result;
+    }
 
-      for(size_t i = 0; i < k; ++i) {
-        result.push_back(nnIdx[i]);
-      }
+    /*----------------------------------------------------------------------------*/
 
-      annDeallocPt(queryPt);
-      delete [] nnIdx;
-      delete [] dists;
+    /* version of get_nearest_neighbors_index() that writes its results into
+     * the provided query object
+     *
+     * ATTENTION: like in the former ANN based implementation, radius is
+     * interpreted as squared radius
+     */
+    void get_nearest_neighbors_index(
+      const arma::vec& point,
+      const double radius,
+      Query& query) const {
 
-      return result;
+      this->tree.radius(
+        point.memptr(), radius, query.indices, query.squaredDistances);
 
     }
 
@@ -191,9 +213,7 @@ class KdTree{
 
     /*----------------------------------------------------------------------------*/
 
-    ANNpointArray dataPts;
-    ANNkd_tree* kdTree;
-    std::vector<arma::vec> points;
+    SpatialTree<double> tree;
 
     /*----------------------------------------------------------------------------*/
 
@@ -0,0 +1,1031 @@
+/****
+   This file is part of the multilinear-model-tools.
+   These tools are meant to derive a multilinear tongue model or
+   PCA palate model from mesh data and work with it.
+
+   Some code of the multilinear-model-tools is based on
+   Timo Bolkart's work on statistical analysis of human face shapes,
+   cf. https://sites.google.com/site/bolkartt/
+
+   Copyright (C) 2016 Alexander Hewer
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+****/
+#ifndef __SPATIAL_TREE_H__
+#define __SPATIAL_TREE_H__
+
+#include <vector>
+#include <algorithm>
+#include <limits>
+
+#include <armadillo>
+
+#include "mesh/PointList.h"
+
+/* header-only bounding volume hierarchy over points or triangles in 3D
+ *
+ * the nodes are stored as flat arrays (structure of arrays), the left child
+ * of an inner node is located directly after its parent, the index of the
+ * right child is stored explicitly
+ *
+ * the tree is built once and can be queried concurrently afterwards,
+ * Scalar is the type of the stored coordinates (float or double)
+ */
+template<typename Scalar>
+class SpatialTree{
+
+public:
+
+  /*--------------------------------------------------------------------------*/
+
+  SpatialTree() {
+    this->isTriangleTree = false;
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  /* builds the tree for a point set */
+  void build_points(const PointList& points) {
+
+    clear();
+
+    this->isTriangleTree = false;
+
+    const int pointAmount = points.size();
+
+    std::vector<Scalar> centers(
+      points.data(), points.data() + 3 * pointAmount);
+
+    build(centers, pointAmount);
+
+    // store coordinates in the order of the leaves
+    this->x.resize(pointAmount);
+    this->y.resize(pointAmount);
+    this->z.resize(pointAmount);
+
+    this->slots.resize(pointAmount);
+
+    for(int slot = 0; slot < pointAmount; ++slot) {
+
+      const int& id = this->ids[slot];
+
+      this->x[slot] = centers[3 * id];
+      this->y[slot] = centers[3 * id + 1];
+      this->z[slot] = centers[3 * id + 2];
+
+      this->slots[id] = slot;
+
+    }
+
+    update_bounds();
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  /* builds the tree for the triangles of a face-vertex mesh,
+   * faces with more than three vertices are split into a triangle fan
+   *
+   * triangle indices used by the queries refer to the generated triangles,
+   * get_face() maps them to the faces of the mesh
+   */
+  void build_triangles(
+    const PointList& vertices,
+    const std::vector< std::vector<unsigned int> >& faces) {
+
+    clear();
+
+    this->isTriangleTree = true;
+
+    // vertex coordinates are stored in their original order
+    this->x.resize(vertices.size());
+    this->y.resize(vertices.size());
+    this->z.resize(vertices.size());
+
+    const double* coordinates = vertices.data();
+
+    for(size_t i = 0; i < vertices.size(); ++i) {
+      this->x[i] = coordinates[3 * i];
+      this->y[i] = coordinates[3 * i + 1];
+      this->z[i] = coordinates[3 * i + 2];
+    }
+
+    std::vector<int> cornerA, cornerB, cornerC;
+
+    for(size_t face = 0; face < faces.size(); ++face) {
+
+      const std::vector<unsigned int>& indices = faces[face];
+
+      for(size_t i = 1; i + 1 < indices.size(); ++i) {
+        cornerA.push_back(indices[0]);
+        cornerB.push_back(indices[i]);
+        cornerC.push_back(indices[i + 1]);
+        this->faceOfTriangle.push_back(face);
+      }
+
+    }
+
+    const int triangleAmount = cornerA.size();
+
+    std::vector<Scalar> centers(3 * triangleAmount);
+
+    for(int i = 0; i < triangleAmount; ++i) {
+      centers[3 * i]     = ( this->x[cornerA[i]] + this->x[cornerB[i]] +
+                             this->x[cornerC[i]] ) / 3;
+      centers[3 * i + 1] = ( this->y[cornerA[i]] + this->y[cornerB[i]] +
+                             this->y[cornerC[i]] ) / 3;
+      centers[3 * i + 2] = ( this->z[cornerA[i]] + this->z[cornerB[i]] +
+                             this->z[cornerC[i]] ) / 3;
+    }
+
+    build(centers, triangleAmount);
+
+    // store corners in the order of the leaves
+    this->a.resize(triangleAmount);
+    this->b.resize(triangleAmount);
+    this->c.resize(triangleAmount);
+
+    this->slots.resize(triangleAmount);
+
+    for(int slot = 0; slot < triangleAmount; ++slot) {
+
+      const int& id = this->ids[slot];
+
+      this->a[slot] = cornerA[id];
+      this->b[slot] = cornerB[id];
+      this->c[slot] = cornerC[id];
+
+      this->slots[id] = slot;
+
+    }
+
+    update_bounds();
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  /* updates the point coordinates without rebuilding the hierarchy,
+   * only the node bounds are recomputed
+   *
+   * returns false if the amount of points changed, the tree has to be
+   * rebuilt in this case
+   *
+   * the hierarchy is kept, hence query performance degrades if the points
+   * move far relative to each other
+   */
+  bool refit_points(const PointList& points) {
+
+    if( this->isTriangleTree == true ||
+        points.size() != this->ids.size() ) {
+      return false;
+    }
+
+    const double* coordinates = points.data();
+
+    for(size_t id = 0; id < points.size(); ++id) {
+
+      const int& slot = this->slots[id];
+
+      this->x[slot] = coordinates[3 * id];
+      this->y[slot] = coordinates[3 * id + 1];
+      this->z[slot] = coordinates[3 * id + 2];
+
+    }
+
+    update_bounds();
+
+    return true;
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  /* updates the vertex coordinates of a triangle tree without rebuilding
+   * the hierarchy, the faces have to be unchanged
+   *
+   * returns false if the amount of vertices changed
+   */
+  bool refit_vertices(const PointList& vertices) {
+
+    if( this->isTriangleTree == false ||
+        vertices.size() != this->x.size() ) {
+      return false;
+    }
+
+    const double* coordinates = vertices.data();
+
+    for(size_t i = 0; i < vertices.size(); ++i) {
+      this->x[i] = coordinates[3 * i];
+      this->y[i] = coordinates[3 * i + 1];
+      this->z[i] = coordinates[3 * i + 2];
+    }
+
+    update_bounds();
+
+    return true;
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  /* returns the index of the point closest to the query point or -1 if
+   * no point was found, e.g., for an empty tree or a NaN query point
+   */
+  int nearest(const Scalar point[3], Scalar& squaredDistance) const {
+
+    int best = -1;
+    squaredDistance = std::numeric_limits<Scalar>::max();
+
+    if( this->first.empty() == true ) {
+      return best;
+    }
+
+    int stack[StackSize];
+    int stackSize = 0;
+
+    stack[stackSize++] = 0;
+
+    while( stackSize > 0 ) {
+
+      const int node = stack[--stackSize];
+
+      if( box_distance(node, point) > squaredDistance ) {
+        continue;
+      }
+
+      if( this->count[node] > 0 ) {
+
+        const int end = this->first[node] + this->count[node];
+
+        for(int slot = this->first[node]; slot < end; ++slot) {
+
+          const Scalar distance = point_distance(slot, point);
+
+          if( distance < squaredDistance ) {
+            squaredDistance = distance;
+            best = slot;
+          }
+
+        }
+
+        continue;
+
+      }
+
+      push_children(node, point, stack, stackSize);
+
+    }
+
+    if( best == -1 ) {
+      return -1;
+    }
+
+    return this->ids[best];
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  /* finds the k points closest to the query point, the results are sorted
+   * by increasing distance
+   */
+  void k_nearest(
+    const Scalar point[3],
+    const int& k,
+    std::vector<int>& indices,
+    std::vector<Scalar>& squaredDistances) const {
+
+    indices.clear();
+    squaredDistances.clear();
+
+    if( this->first.empty() == true || k <= 0 ) {
+      return;
+    }
+
+    Scalar bound = std::numeric_limits<Scalar>::max();
+
+    int stack[StackSize];
+    int stackSize = 0;
+
+    stack[stackSize++] = 0;
+
+    while( stackSize > 0 ) {
+
+      const int node = stack[--stackSize];
+
+      if( box_distance(node, point) > bound ) {
+        continue;
+      }
+
+      if( this->count[node] > 0 ) {
+
+        const int end = this->first[node] + this->count[node];
+
+        for(int slot = this->first[node]; slot < end; ++slot) {
+
+          const Scalar distance = point_distance(slot, point);
+
+          if( (int) indices.size() == k && distance >= bound ) {
+            continue;
+          }
+
+          // sorted insertion, k is expected to be small
+          int position = indices.size();
+
+          if( position == k ) {
+            --position;
+          }
+          else {
+            indices.push_back(0);
+            squaredDistances.push_back(0);
+          }
+
+          while( position > 0 && squaredDistances[position - 1] > distance ) {
+            indices[position] = indices[position - 1];
+            squaredDistances[position] = squaredDistances[position - 1];
+            --position;
+          }
+
+          indices[position] = slot;
+          squaredDistances[position] = distance;
+
+          if( (int) indices.size() == k ) {
+            bound = squaredDistances.back();
+          }
+
+        }
+
+        continue;
+
+      }
+
+      push_children(node, point, stack, stackSize);
+
+    }
+
+    for(int& index: indices) {
+      index = this->ids[index];
+    }
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  /* finds all points whose squared distance to the query point does not
+   * exceed squaredRadius, the provided vectors keep their capacity
+   */
+  void radius(
+    const Scalar point[3],
+    const Scalar& squaredRadius,
+    std::vector<int>& indices,
+    std::vector<Scalar>& squaredDistances) const {
+
+    indices.clear();
+    squaredDistances.clear();
+
+    if( this->first.empty() == true ) {
+      return;
+    }
+
+    int stack[StackSize];
+    int stackSize = 0;
+
+    stack[stackSize++] = 0;
+
+    while( stackSize > 0 ) {
+
+      const int node = stack[--stackSize];
+
+      if( box_distance(node, point) > squaredRadius ) {
+        continue;
+      }
+
+      if( this->count[node] > 0 ) {
+
+        const int end = this->first[node] + this->count[node];
+
+        for(int slot = this->first[node]; slot < end; ++slot) {
+
+          const Scalar distance = point_distance(slot, point);
+
+          if( distance <= squaredRadius ) {
+            indices.push_back(this->ids[slot]);
+            squaredDistances.push_back(distance);
+          }
+
+        }
+
+        continue;
+
+      }
+
+      stack[stackSize++] = this->rightChild[node];
+      stack[stackSize++] = node + 1;
+
+    }
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  /* finds the point on the triangles closest to the query point,
+   * returns the index of the corresponding triangle or -1 if no triangle
+   * was found, e.g., for an empty tree or a NaN query point
+   */
+  int closest_triangle(
+    const Scalar point[3],
+    Scalar closestPoint[3],
+    Scalar& squaredDistance) const {
+
+    int best = -1;
+    squaredDistance = std::numeric_limits<Scalar>::max();
+
+    if( this->first.empty() == true ) {
+      return best;
+    }
+
+    int stack[StackSize];
+    int stackSize = 0;
+
+    stack[stackSize++] = 0;
+
+    Scalar candidate[3];
+
+    while( stackSize > 0 ) {
+
+      const int node = stack[--stackSize];
+
+      if( box_distance(node, point) > squaredDistance ) {
+        continue;
+      }
+
+      if( this->count[node] > 0 ) {
+
+        const int end = this->first[node] + this->count[node];
+
+        for(int slot = this->first[node]; slot < end; ++slot) {
+
+          closest_point_on_triangle(slot, point, candidate);
+
+          const Scalar dx = candidate[0] - point[0];
+          const Scalar dy = candidate[1] - point[1];
+          const Scalar dz = candidate[2] - point[2];
+
+          const Scalar distance = dx * dx + dy * dy + dz * dz;
+
+          if( distance < squaredDistance ) {
+            squaredDistance = distance;
+            best = slot;
+            closestPoint[0] = candidate[0];
+            closestPoint[1] = candidate[1];
+            closestPoint[2] = candidate[2];
+          }
+
+        }
+
+        continue;
+
+      }
+
+      push_children(node, point, stack, stackSize);
+
+    }
+
+    if( best == -1 ) {
+      return -1;
+    }
+
+    return this->ids[best];
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  /* returns the coordinates of the point with the given index,
+   * only available for point trees
+   */
+  void get_point(const int& index, Scalar point[3]) const {
+
+    const int& slot = this->slots.at(index);
+
+    point[0] = this->x[slot];
+    point[1] = this->y[slot];
+    point[2] = this->z[slot];
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  /* returns the vertex indices of the corners of the given triangle,
+   * only available for triangle trees
+   */
+  void get_triangle(const int& triangle, int corners[3]) const {
+
+    const int& slot = this->slots.at(triangle);
+
+    corners[0] = this->a[slot];
+    corners[1] = this->b[slot];
+    corners[2] = this->c[slot];
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  /* returns the index of the mesh face the given triangle belongs to */
+  int get_face(const int& triangle) const {
+    return this->faceOfTriangle.at(triangle);
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  /* amount of stored points or triangles */
+  int size() const {
+    return this->ids.size();
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+private:
+
+  /*--------------------------------------------------------------------------*/
+
+  // maximum amount of primitives in a leaf
+  static const int LeafSize = 8;
+
+  // sets up to this size are scanned linearly
+  static const int BruteForceSize = 64;
+
+  // median splits keep the depth logarithmic in the amount of primitives
+  static const int StackSize = 128;
+
+  /*--------------------------------------------------------------------------*/
+
+  void clear() {
+
+    this->x.clear();
+    this->y.clear();
+    this->z.clear();
+
+    this->a.clear();
+    this->b.clear();
+    this->c.clear();
+
+    this->ids.clear();
+    this->slots.clear();
+    this->faceOfTriangle.clear();
+
+    this->lowerX.clear();
+    this->lowerY.clear();
+    this->lowerZ.clear();
+    this->upperX.clear();
+    this->upperY.clear();
+    this->upperZ.clear();
+
+    this->first.clear();
+    this->count.clear();
+    this->rightChild.clear();
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  /* builds the node hierarchy by median splits of the primitive centers,
+   * afterwards ids maps the leaf order to the original primitive indices
+   */
+  void build(const std::vector<Scalar>& centers, const int& primitiveAmount) {
+
+    this->ids.resize(primitiveAmount);
+
+    for(int i = 0; i < primitiveAmount; ++i) {
+      this->ids[i] = i;
+    }
+
+    if( primitiveAmount == 0 ) {
+      return;
+    }
+
+    // small sets are stored in a single leaf, i.e. they are scanned
+    // linearly without constructing a hierarchy
+    if( primitiveAmount <= BruteForceSize ) {
+      add_node(0, primitiveAmount);
+      return;
+    }
+
+    const int nodeAmount = 2 * ( primitiveAmount / LeafSize + 1 );
+
+    this->lowerX.reserve(nodeAmount);
+    this->lowerY.reserve(nodeAmount);
+    this->lowerZ.reserve(nodeAmount);
+    this->upperX.reserve(nodeAmount);
+    this->upperY.reserve(nodeAmount);
+    this->upperZ.reserve(nodeAmount);
+    this->first.reserve(nodeAmount);
+    this->count.reserve(nodeAmount);
+    this->rightChild.reserve(nodeAmount);
+
+    build_node(centers, 0, primitiveAmount);
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  int build_node(
+    const std::vector<Scalar>& centers,
+    const int& begin,
+    const int& amount) {
+
+    const int node = add_node(begin, amount);
+
+    if( amount <= LeafSize ) {
+      return node;
+    }
+
+    // split along the axis with the largest extent of the centers
+    Scalar lower[3] = {
+      std::numeric_limits<Scalar>::max(),
+      std::numeric_limits<Scalar>::max(),
+      std::numeric_limits<Scalar>::max() };
+
+    Scalar upper[3] = {
+      std::numeric_limits<Scalar>::lowest(),
+      std::numeric_limits<Scalar>::lowest(),
+      std::numeric_limits<Scalar>::lowest() };
+
+    for(int i = begin; i < begin + amount; ++i) {
+      for(int j = 0; j < 3; ++j) {
+        lower[j] = std::min(lower[j], centers[3 * this->ids[i] + j]);
+        upper[j] = std::max(upper[j], centers[3 * this->ids[i] + j]);
+      }
+    }
+
+    int axis = 0;
+
+    for(int j = 1; j < 3; ++j) {
+      if( upper[j] - lower[j] > upper[axis] - lower[axis] ) {
+        axis = j;
+      }
+    }
+
+    const int half = amount / 2;
+
+    std::nth_element(
+      this->ids.begin() + begin,
+      this->ids.begin() + begin + half,
+      this->ids.begin() + begin + amount,
+      [&centers, axis](const int& lhs, const int& rhs) {
+        return centers[3 * lhs + axis] < centers[3 * rhs + axis];
+      });
+
+    this->count[node] = 0;
+
+    build_node(centers, begin, half);
+
+    // node arrays may be reallocated while building the children
+    const int right = build_node(centers, begin + half, amount - half);
+
+    this->rightChild[node] = right;
+
+    return node;
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  /* adds a leaf node for the given primitive range,
+   * bounds are set by update_bounds()
+   */
+  int add_node(const int& begin, const int& amount) {
+
+    const int node = this->first.size();
+
+    this->lowerX.push_back(0);
+    this->lowerY.push_back(0);
+    this->lowerZ.push_back(0);
+    this->upperX.push_back(0);
+    this->upperY.push_back(0);
+    this->upperZ.push_back(0);
+    this->first.push_back(begin);
+    this->count.push_back(amount);
+    this->rightChild.push_back(-1);
+
+    return node;
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  /* computes the bounds of all nodes from the stored coordinates,
+   * children are always stored after their parent, hence a reverse pass
+   * visits them first
+   */
+  void update_bounds() {
+
+    for(int node = this->first.size() - 1; node >= 0; --node) {
+
+      if( this->count[node] > 0 ) {
+        update_leaf_bounds(node);
+        continue;
+      }
+
+      const int left = node + 1;
+      const int right = this->rightChild[node];
+
+      // bounds of inner nodes enclose the bounds of their children
+      this->lowerX[node] = std::min(this->lowerX[left], this->lowerX[right]);
+      this->lowerY[node] = std::min(this->lowerY[left], this->lowerY[right]);
+      this->lowerZ[node] = std::min(this->lowerZ[left], this->lowerZ[right]);
+      this->upperX[node] = std::max(this->upperX[left], this->upperX[right]);
+      this->upperY[node] = std::max(this->upperY[left], this->upperY[right]);
+      this->upperZ[node] = std::max(this->upperZ[left], this->upperZ[right]);
+
+    }
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  void update_leaf_bounds(const int& node) {
+
+    Scalar lower[3] = {
+      std::numeric_limits<Scalar>::max(),
+      std::numeric_limits<Scalar>::max(),
+      std::numeric_limits<Scalar>::max() };
+
+    Scalar upper[3] = {
+      std::numeric_limits<Scalar>::lowest(),
+      std::numeric_limits<Scalar>::lowest(),
+      std::numeric_limits<Scalar>::lowest() };
+
+    const int end = this->first[node] + this->count[node];
+
+    for(int slot = this->first[node]; slot < end; ++slot) {
+
+      if( this->isTriangleTree == false ) {
+
+        lower[0] = std::min(lower[0], this->x[slot]);
+        lower[1] = std::min(lower[1], this->y[slot]);
+        lower[2] = std::min(lower[2], this->z[slot]);
+
+        upper[0] = std::max(upper[0], this->x[slot]);
+        upper[1] = std::max(upper[1], this->y[slot]);
+        upper[2] = std::max(upper[2], this->z[slot]);
+
+        continue;
+
+      }
+
+      const int corners[3] = { this->a[slot], this->b[slot], this->c[slot] };
+
+      for(const int& corner: corners) {
+
+        lower[0] = std::min(lower[0], this->x[corner]);
+        lower[1] = std::min(lower[1], this->y[corner]);
+        lower[2] = std::min(lower[2], this->z[corner]);
+
+        upper[0] = std::max(upper[0], this->x[corner]);
+        upper[1] = std::max(upper[1], this->y[corner]);
+        upper[2] = std::max(upper[2], this->z[corner]);
+
+      }
+
+    }
+
+    this->lowerX[node] = lower[0];
+    this->lowerY[node] = lower[1];
+    this->lowerZ[node] = lower[2];
+    this->upperX[node] = upper[0];
+    this->upperY[node] = upper[1];
+    this->upperZ[node] = upper[2];
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  /* pushes both children of an inner node, the closer child is visited
+   * first
+   */
+  void push_children(
+    const int& node,
+    const Scalar point[3],
+    int stack[],
+    int& stackSize) const {
+
+    const int left = node + 1;
+    const int right = this->rightChild[node];
+
+    if( box_distance(left, point) < box_distance(right, point) ) {
+      stack[stackSize++] = right;
+      stack[stackSize++] = left;
+    }
+    else {
+      stack[stackSize++] = left;
+      stack[stackSize++] = right;
+    }
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  /* squared distance between the bounding box of a node and a point */
+  Scalar box_distance(const int& node, const Scalar point[3]) const {
+
+    Scalar distance = 0;
+
+    const Scalar dx = std::max(
+      std::max(this->lowerX[node] - point[0], point[0] - this->upperX[node]),
+      Scalar(0));
+
+    const Scalar dy = std::max(
+      std::max(this->lowerY[node] - point[1], point[1] - this->upperY[node]),
+      Scalar(0));
+
+    const Scalar dz = std::max(
+      std::max(this->lowerZ[node] - point[2], point[2] - this->upperZ[node]),
+      Scalar(0));
+
+    distance = dx * dx + dy * dy + dz * dz;
+
+    return distance;
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  Scalar point_distance(const int& slot, const Scalar point[3]) const {
+
+    const Scalar dx = this->x[slot] - point[0];
+    const Scalar dy = this->y[slot] - point[1];
+    const Scalar dz = this->z[slot] - point[2];
+
+    return dx * dx + dy * dy + dz * dz;
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  /* closest point on a triangle by classifying the query point against the
+   * Voronoi regions of the triangle, see Ericson: Real-Time Collision
+   * Detection, section 5.1.5
+   */
+  void closest_point_on_triangle(
+    const int& slot,
+    const Scalar point[3],
+    Scalar result[3]) const {
+
+    const Scalar pa[3] = {
+      this->x[this->a[slot]], this->y[this->a[slot]], this->z[this->a[slot]] };
+    const Scalar pb[3] = {
+      this->x[this->b[slot]], this->y[this->b[slot]], this->z[this->b[slot]] };
+    const Scalar pc[3] = {
+      this->x[this->c[slot]], this->y[this->c[slot]], this->z[this->c[slot]] };
+
+    Scalar ab[3], ac[3], ap[3], bp[3], cp[3];
+
+    for(int j = 0; j < 3; ++j) {
+      ab[j] = pb[j] - pa[j];
+      ac[j] = pc[j] - pa[j];
+      ap[j] = point[j] - pa[j];
+      bp[j] = point[j] - pb[j];
+      cp[j] = point[j] - pc[j];
+    }
+
+    const Scalar d1 = dot(ab, ap);
+    const Scalar d2 = dot(ac, ap);
+
+    // vertex region of a
+    if( d1 <= 0 && d2 <= 0 ) {
+      copy(pa, result);
+      return;
+    }
+
+    const Scalar d3 = dot(ab, bp);
+    const Scalar d4 = dot(ac, bp);
+
+    // vertex region of b
+    if( d3 >= 0 && d4 <= d3 ) {
+      copy(pb, result);
+      return;
+    }
+
+    // edge region of ab
+    const Scalar vc = d1 * d4 - d3 * d2;
+
+    if( vc <= 0 && d1 >= 0 && d3 <= 0 ) {
+      const Scalar v = d1 / ( d1 - d3 );
+      for(int j = 0; j < 3; ++j) {
+        result[j] = pa[j] + v * ab[j];
+      }
+      return;
+    }
+
+    const Scalar d5 = dot(ab, cp);
+    const Scalar d6 = dot(ac, cp);
+
+    // vertex region of c
+    if( d6 >= 0 && d5 <= d6 ) {
+      copy(pc, result);
+      return;
+    }
+
+    // edge region of ac
+    const Scalar vb = d5 * d2 - d1 * d6;
+
+    if( vb <= 0 && d2 >= 0 && d6 <= 0 ) {
+      const Scalar w = d2 / ( d2 - d6 );
+      for(int j = 0; j < 3; ++j) {
+        result[j] = pa[j] + w * ac[j];
+      }
+      return;
+    }
+
+    // edge region of bc
+    const Scalar va = d3 * d6 - d5 * d4;
+
+    if( va <= 0 && ( d4 - d3 ) >= 0 && ( d5 - d6 ) >= 0 ) {
+      const Scalar w = ( d4 - d3 ) / ( ( d4 - d3 ) + ( d5 - d6 ) );
+      for(int j = 0; j < 3; ++j) {
+        result[j] = pb[j] + w * ( pc[j] - pb[j] );
+      }
+      return;
+    }
+
+    // inside of the triangle
+    const Scalar denominator = 1 / ( va + vb + vc );
+    const Scalar v = vb * denominator;
+    const Scalar w = vc * denominator;
+
+    for(int j = 0; j < 3; ++j) {
+      result[j] = pa[j] + ab[j] * v + ac[j] * w;
+    }
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  static Scalar dot(const Scalar u[3], const Scalar v[3]) {
+    return u[0] * v[0] + u[1] * v[1] + u[2] * v[2];
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  static void copy(const Scalar source[3], Scalar target[3]) {
+    target[0] = source[0];
+    target[1] = source[1];
+    target[2] = source[2];
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  bool isTriangleTree;
+
+  // point coordinates in leaf order or triangle vertices in original order
+  std::vector<Scalar> x;
+  std::vector<Scalar> y;
+  std::vector<Scalar> z;
+
+  // triangle corners in leaf order
+  std::vector<int> a;
+  std::vector<int> b;
+  std::vector<int> c;
+
+  // original index of the primitive at each leaf position
+  std::vector<int> ids;
+
+  // leaf position of each point or triangle
+  std::vector<int> slots;
+
+  // face of the mesh each triangle was generated from
+  std::vector<int> faceOfTriangle;
+
+  // node bounds
+  std::vector<Scalar> lowerX;
+  std::vector<Scalar> lowerY;
+  std::vector<Scalar> lowerZ;
+  std::vector<Scalar> upperX;
+  std::vector<Scalar> upperY;
+  std::vector<Scalar> upperZ;
+
+  // primitive range of leaves (count is 0 for inner nodes)
+  std::vector<int> first;
+  std::vector<int> count;
+
+  std::vector<int> rightChild;
+
+  /*--------------------------------------------------------------------------*/
+
+};
+
+#endif
@@ -32,7 +32,10 @@
 
 #include <armadillo>
 
-/* class for basic storage of a face-vertex mesh */
+#include "mesh/PointList.h"
+
+/* class for basic storage of a face-vertex mesh,
+   vertex positions, normals and colors are stored contiguously */
 
 class Mesh{
   public:
@@ -41,7 +44,7 @@ class Mesh{
     // SETTERS
     /*-------------------------------------------------------------------------*/
 
-    Mesh& set_vertices(const std::vector<arma::vec>& vertices) {
+    Mesh& set_vertices(const PointList& vertices) {
 
       this->vertices = vertices;
       return *this;
@@ -50,7 +53,7 @@ class Mesh{
 
     /*-------------------------------------------------------------------------*/
 
-    Mesh& set_vertex_normals(const std::vector<arma::vec>& vertexNormals) {
+    Mesh& set_vertex_normals(const PointList& vertexNormals) {
 
       if( vertexNormals.size() != this->vertices.size() ) {
         throw std::runtime_error(
@@ -63,7 +66,7 @@ class Mesh{
 
     /*-------------------------------------------------------------------------*/
 
-    Mesh& set_vertex_colors(const std::vector<arma::vec>& vertexColors) {
+    Mesh& set_vertex_colors(const PointList& vertexColors) {
 
       if( vertexColors.size() != this->vertices.size() ) {
         throw std::runtime_error(
@@ -120,10 +123,9 @@ class Mesh{
     // ADDERS
     /*-------------------------------------------------------------------------*/
 
-    Mesh& add_vertices(const std::vector<arma::vec>& vertices) {
+    Mesh& add_vertices(const PointList& vertices) {
 
-      this->vertices.insert(
-        this->vertices.end(), vertices.begin(), vertices.end());
+      this->vertices.append(vertices);
 
       return *this;
 
@@ -131,10 +133,9 @@ class Mesh{
 
     /*-------------------------------------------------------------------------*/
 
-    Mesh& add_vertex_normals(const std::vector<arma::vec>& vertexNormals) {
+    Mesh& add_vertex_normals(const PointList& vertexNormals) {
 
-      this->vertexNormals.insert(
-        this->vertexNormals.end(), vertexNormals.begin(), vertexNormals.end());
+      this->vertexNormals.append(vertexNormals);
 
       return *this;
 
@@ -158,41 +159,41 @@ class Mesh{
     // GETTERS
     /*-------------------------------------------------------------------------*/
 
-    std::vector<arma::vec>& get_vertices() {
+    PointList& get_vertices() {
       return this->vertices;
     }
 
     /*-------------------------------------------------------------------------*/
 
     // const version
-    const std::vector<arma::vec>& get_vertices() const {
+    const PointList& get_vertices() const {
       return this->vertices;
     }
 
 
     /*-------------------------------------------------------------------------*/
 
-    std::vector<arma::vec>& get_vertex_normals() {
+    PointList& get_vertex_normals() {
       return this->vertexNormals;
     }
 
     /*-------------------------------------------------------------------------*/
 
     // const version
-    const std::vector<arma::vec>& get_vertex_normals() const {
+    const PointList& get_vertex_normals() const {
       return this->vertexNormals;
     }
 
     /*-------------------------------------------------------------------------*/
 
-    std::vector<arma::vec>& get_vertex_colors() {
+    PointList& get_vertex_colors() {
       return this->vertexColors;
     }
 
     /*-------------------------------------------------------------------------*/
 
     // const version
-    const std::vector<arma::vec>& get_vertex_colors() const {
+    const PointList& get_vertex_colors() const {
       return this->vertexColors;
     }
 
@@ -278,13 +279,7 @@ class Mesh{
 
     const arma::vec get_center() const {
 
-      arma::vec mean = arma::zeros<arma::vec>(3);
-
-      for( const auto& point: this->vertices) {
-        mean += point;
-      }
-
-      return mean / this->vertices.size();
+      return arma::mean(this->vertices.matrix(), 1);
     }
 
     /*-------------------------------------------------------------------------*/
@@ -324,9 +319,9 @@ class Mesh{
 
   protected:
 
-    std::vector<arma::vec> vertices;
-    std::vector<arma::vec> vertexNormals;
-    std::vector<arma::vec> vertexColors;
+    PointList vertices;
+    PointList vertexNormals;
+    PointList vertexColors;
 
     std::vector<bool> vertexBoundaryMarkers;
     std::vector<bool> faceBoundaryMarkers;
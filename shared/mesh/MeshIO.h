@@ -35,6 +35,8 @@
 #include "mesh/reader/PlyReader.h"
 #include "mesh/reader/MdlReader.h"
 #include "mesh/reader/MatReader.h"
+#include "mesh/reader/MappedPlyReader.h"
+#include "mesh/reader/MappedObjReader.h"
 
 #include "mesh/writer/MeshWriter.h"
 #include "mesh/writer/ObjWriter.h"
@@ -57,12 +59,13 @@ class MeshIO{
 
       extension = match[1];
 
+      // text formats are parsed in place from a memory mapped file
       if( extension == "ply" ) {
-        PlyReader reader;
+        MappedPlyReader reader;
         return reader.read_mesh_from(file);
       }
       else if( extension == "obj" ) {
-        ObjReader reader;
+        MappedObjReader reader;
         return reader.read_mesh_from(file);
       }
       else if( extension == "mdl" ) {
@@ -81,7 +84,9 @@ class MeshIO{
 
     /*---------------------------------------------------------------------------*/
 
-    static void write(const Mesh& mesh, const std::string& file) {
+    static void write(
+      const Mesh& mesh, const std::string& file,
+      const PlyWriter::Format& plyFormat = PlyWriter::Format::ASCII) {
       
       std::regex regEx("[.]([[:alpha:]]+)$");
       std::smatch match;
@@ -92,7 +97,7 @@ class MeshIO{
       extension = match[1];
 
       if( extension == "ply" ) {
-        PlyWriter writer(mesh);
+        PlyWriter writer(mesh, plyFormat);
         writer.write_mesh_to(file);
  
       }
@@ -27,129 +27,319 @@
 #define __NORMAL_ESTIMATION_H__
 
 #include <vector>
+#include <cmath>
+#include <stdexcept>
 #include <armadillo>
 
 #include "Mesh.h"
+#include "utility/ParallelRanges.h"
 
 // Based on Timo's code for computing normals,
 // cf. Weights for Computing Vertex Normals from Facet Normals by Nelson Max
+//
+// the corners of every vertex are cached, hence one object can be reused
+// for recomputing the normals while only the vertex positions change
 class NormalEstimation{
 
   public:
 
     /*-------------------------------------------------------------------------*/
 
-    NormalEstimation(Mesh& mesh) :
-      vertices(mesh.get_vertices()),
-      faces(mesh.get_faces()) {
+    NormalEstimation() {
 
-      init_vertex_handles();
+      this->mesh = nullptr;
+      this->vertexAmount = 0;
+      this->faceAmount = 0;
+      this->threadAmount = 1;
 
     }
 
     /*-------------------------------------------------------------------------*/
 
-    void set_mesh(Mesh& mesh) {
-        this->vertices = mesh.get_vertices();
-        this->faces = mesh.get_faces();
-        init_vertex_handles();
+    NormalEstimation(const Mesh& mesh) : NormalEstimation() {
+
+      set_mesh(mesh);
+
     }
 
     /*-------------------------------------------------------------------------*/
 
-    std::vector<arma::vec> compute() {
-
-      std::vector<arma::vec> result;
+    /* the corner cache is only rebuilt if a different mesh is set or the
+     * amount of vertices or faces changed, the faces must not be modified
+     * otherwise
+     */
+    void set_mesh(const Mesh& mesh) {
 
-      for(size_t i = 0; i < this->vertices.size(); ++i) {
-        result.push_back(compute_normal(i));
+      if( this->mesh == &mesh &&
+          this->vertexAmount == mesh.get_vertex_amount() &&
+          this->faceAmount == mesh.get_face_amount() ) {
+        return;
       }
 
+      this->mesh = &mesh;
+      this->vertexAmount = mesh.get_vertex_amount();
+      this->faceAmount = mesh.get_face_amount();
+
+      init_corners();
+
+    }
+
+    /*-------------------------------------------------------------------------*/
+
+    NormalEstimation& set_thread_amount(const int& threadAmount) {
+
+      this->threadAmount = threadAmount;
+      return *this;
+
+    }
+
+    /*-------------------------------------------------------------------------*/
+
+    PointList compute() {
+
+      PointList result;
+
+      compute(result);
+
       return result;
 
     }
 
     /*-------------------------------------------------------------------------*/
 
+    /* version of compute() that writes into the provided list,
+     * the list may be the vertex normal storage of the mesh itself
+     */
+    void compute(PointList& normals) {
+
+      if( this->mesh == nullptr ) {
+        throw std::runtime_error("No mesh set for normal estimation.");
+      }
+
+      set_mesh(*this->mesh);
+
+      normals.resize(this->vertexAmount);
+
+      const int faceRanges =
+        ParallelRanges::range_amount(this->faceAmount, this->threadAmount);
+
+      ParallelRanges::process_ranges(this->faceAmount, faceRanges,
+        [this](const int&, const int& begin, const int& end) {
+          compute_triangle_normals(begin, end);
+        });
+
+      const int vertexRanges =
+        ParallelRanges::range_amount(this->vertexAmount, this->threadAmount);
+
+      double* result = normals.data();
+
+      ParallelRanges::process_ranges(this->vertexAmount, vertexRanges,
+        [this, result](const int&, const int& begin, const int& end) {
+          compute_normals(begin, end, result);
+        });
+
+    }
+
+    /*-------------------------------------------------------------------------*/
+
   private:
 
     /*-------------------------------------------------------------------------*/
 
-    // build mapping vertex -> faces
-    void init_vertex_handles() {
+    // build mapping vertex -> corners in compressed row layout
+    void init_corners() {
 
-      this->vertexHandles.clear();
-      this->vertexHandles.resize(this->vertices.size());
+      const std::vector<std::vector<unsigned int> >& faces =
+        this->mesh->get_faces();
 
-      for(size_t i = 0; i < this->faces.size(); ++i) {
+      this->cornerOffsets.assign(this->vertexAmount + 1, 0);
 
-        // get vertex ids forming the face
-        const auto faceVertices = faces.at(i);
+      for(const std::vector<unsigned int>& face: faces) {
+        for(const unsigned int& index: face) {
+
+          if( index >= this->vertexAmount ) {
+            throw std::runtime_error(
+              "Face references a vertex that does not exist.");
+          }
+
+          ++this->cornerOffsets[index + 1];
 
-        for(const unsigned int& index: faceVertices ) {
-          this->vertexHandles[index].push_back(i);
         }
       }
 
-      return;
+      for(size_t i = 0; i < this->vertexAmount; ++i) {
+        this->cornerOffsets[i + 1] += this->cornerOffsets[i];
+      }
+
+      const unsigned int cornerAmount = this->cornerOffsets.back();
+
+      this->cornerLeft.resize(cornerAmount);
+      this->cornerRight.resize(cornerAmount);
+      this->cornerTriangle.resize(cornerAmount);
+
+      std::vector<unsigned int> position(
+        this->cornerOffsets.begin(), this->cornerOffsets.end() - 1);
+
+      for(size_t faceId = 0; faceId < faces.size(); ++faceId) {
+
+        const std::vector<unsigned int>& face = faces[faceId];
+
+        // compute amount of participating vertices for this face
+        const unsigned int size = face.size();
+
+        for(size_t i = 0; i < size; ++i) {
+
+          const unsigned int corner = position[face[i]]++;
+
+          // indices of left and right neighbor of the vertex
+          this->cornerLeft[corner] = face[(i + size - 1) % size];
+          this->cornerRight[corner] = face[(i + 1) % size];
+
+          // the facet normal of a triangle is the same for all corners
+          this->cornerTriangle[corner] = ( size == 3 )? faceId: -1;
+
+        }
+
+      }
+
+      this->triangleNormals.resize(3 * faces.size());
+
     }
 
     /*-------------------------------------------------------------------------*/
 
-    /* compute normal for vertex with the specified id */
-    arma::vec compute_normal(const unsigned int& id) const {
+    /* unnormalized facet normals of the triangles in [begin, end) */
+    void compute_triangle_normals(const int& begin, const int& end) {
 
-      // get current vertex
-      const arma::vec& current = this->vertices.at(id);
-      arma::vec normal = arma::zeros(3);
+      const double* points = this->mesh->get_vertices().data();
+      const std::vector<std::vector<unsigned int> >& faces =
+        this->mesh->get_faces();
 
-      // process all faces this vertex belongs to
-      for(const unsigned int& faceId: this->vertexHandles.at(id) ) {
+      for(int faceId = begin; faceId < end; ++faceId) {
 
-        const auto& faceVertices = this->faces.at(faceId);
+        const std::vector<unsigned int>& face = faces[faceId];
 
-        // compute amount of participating vertices for this face
-        const unsigned int size = faceVertices.size();
+        if( face.size() != 3 ) {
+          continue;
+        }
+
+        const double* a = points + 3 * face[0];
+        const double* b = points + 3 * face[1];
+        const double* c = points + 3 * face[2];
+
+        double right[3];
+        double left[3];
+
+        for(int j = 0; j < 3; ++j) {
+          right[j] = b[j] - a[j];
+          left[j] = c[j] - a[j];
+        }
+
+        cross(right, left, this->triangleNormals.data() + 3 * faceId);
+
+      }
+
+    }
+
+    /*-------------------------------------------------------------------------*/
+
+    /* normals of the vertices in [begin, end) */
+    void compute_normals(const int& begin, const int& end, double* result) {
+
+      const double* points = this->mesh->get_vertices().data();
+
+      for(int id = begin; id < end; ++id) {
+
+        // get current vertex
+        const double* current = points + 3 * id;
+        double normal[3] = {0, 0, 0};
 
-        // find position of vertex inside face
-        for(size_t i = 0; i < faceVertices.size(); ++i) {
+        // process all corners of this vertex
+        for(unsigned int corner = this->cornerOffsets[id];
+            corner < this->cornerOffsets[id + 1]; ++corner) {
 
-          if(faceVertices.at(i) == id) {
+          const double* leftPoint = points + 3 * this->cornerLeft[corner];
+          const double* rightPoint = points + 3 * this->cornerRight[corner];
 
-            // get indices of left and right neighbor of current vertex
-            const unsigned int leftIndex  =
-              faceVertices.at((i + size - 1) % size);
-            const unsigned int rightIndex =
-              faceVertices.at((i + 1    ) % size);
+          // center both vertices at current vertex
+          double left[3];
+          double right[3];
 
-            // center both vertices at current vertex
-            const arma::vec left =
-              this->vertices.at(leftIndex) - current;
-            const arma::vec right =
-              this->vertices.at(rightIndex) - current;
+          for(int j = 0; j < 3; ++j) {
+            left[j] = leftPoint[j] - current[j];
+            right[j] = rightPoint[j] - current[j];
+          }
 
-            // compute facet normal
-            const arma::vec facetNormal =
-              arma::cross(right, left) /
-              ( arma::dot(left, left) + arma::dot(right, right));
+          double facetNormal[3];
 
-            normal += facetNormal;
+          if( this->cornerTriangle[corner] >= 0 ) {
 
-          } // end if
+            const double* triangleNormal =
+              this->triangleNormals.data() + 3 * this->cornerTriangle[corner];
 
-        } // end for i
+            for(int j = 0; j < 3; ++j) {
+              facetNormal[j] = triangleNormal[j];
+            }
 
-      } // end for faceId
+          }
+          else {
+            cross(right, left, facetNormal);
+          }
 
-      return arma::normalise(normal);
+          const double weight = 1. / ( dot(left, left) + dot(right, right) );
+
+          for(int j = 0; j < 3; ++j) {
+            normal[j] += weight * facetNormal[j];
+          }
+
+        } // end for corner
+
+        const double length = std::sqrt(dot(normal, normal));
+
+        for(int j = 0; j < 3; ++j) {
+          result[3 * id + j] = ( length > 0 )? normal[j] / length: normal[j];
+        }
+
+      } // end for id
+
+    }
+
+    /*-------------------------------------------------------------------------*/
+
+    static void cross(const double u[3], const double v[3], double result[3]) {
+
+      result[0] = u[1] * v[2] - u[2] * v[1];
+      result[1] = u[2] * v[0] - u[0] * v[2];
+      result[2] = u[0] * v[1] - u[1] * v[0];
 
     }
 
     /*-------------------------------------------------------------------------*/
 
-    std::vector<std::vector<unsigned int> > vertexHandles;
+    static double dot(const double u[3], const double v[3]) {
+
+      return u[0] * v[0] + u[1] * v[1] + u[2] * v[2];
+
+    }
+
+    /*-------------------------------------------------------------------------*/
+
+    const Mesh* mesh;
+
+    size_t vertexAmount;
+    size_t faceAmount;
+
+    int threadAmount;
+
+    // corners of vertex i are stored in [cornerOffsets[i], cornerOffsets[i + 1])
+    std::vector<unsigned int> cornerOffsets;
+    std::vector<unsigned int> cornerLeft;
+    std::vector<unsigned int> cornerRight;
+
+    // face index if the corner belongs to a triangle, -1 otherwise
+    std::vector<int> cornerTriangle;
 
-    std::vector<arma::vec>& vertices;
-    std::vector<std::vector<unsigned int> >& faces;
+    // unnormalized facet normals, only set for triangles
+    std::vector<double> triangleNormals;
 };
 #endif
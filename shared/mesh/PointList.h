@@ -0,0 +1,388 @@
+/****
+   This file is part of the multilinear-model-tools.
+   These tools are meant to derive a multilinear tongue model or
+   PCA palate model from mesh data and work with it.
+
+   Some code of the multilinear-model-tools is based on
+   Timo Bolkart's work on statistical analysis of human face shapes,
+   cf. https://sites.google.com/site/bolkartt/
+
+   Copyright (C) 2016 Alexander Hewer
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+****/
+#ifndef __POINT_LIST_H__
+#define __POINT_LIST_H__
+
+#include <vector>
+#include <utility>
+#include <cstddef>
+#include <iterator>
+#include <algorithm>
+#include <stdexcept>
+
+#include <armadillo>
+
+/* contiguous storage of 3D points as columns of a 3 x N matrix,
+   single points are accessed as column views that do not copy data,
+   the views are invalidated like vector iterators when the list grows */
+class PointList{
+
+public:
+
+  /*-------------------------------------------------------------------------*/
+
+  template<bool isConst>
+  class Iterator{
+
+  public:
+
+    typedef typename std::conditional<
+      isConst, const arma::mat*, arma::mat*>::type Matrix;
+
+    typedef typename std::conditional<
+      isConst,
+      const arma::subview_col<double>,
+      arma::subview_col<double> >::type reference;
+
+    typedef std::forward_iterator_tag iterator_category;
+    typedef arma::vec value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef void pointer;
+
+    Iterator(Matrix matrix, const size_t& index) :
+      matrix(matrix), index(index) {
+    }
+
+    reference operator*() const {
+      return this->matrix->col(this->index);
+    }
+
+    Iterator& operator++() {
+      ++this->index;
+      return *this;
+    }
+
+    bool operator==(const Iterator& other) const {
+      return this->index == other.index;
+    }
+
+    bool operator!=(const Iterator& other) const {
+      return this->index != other.index;
+    }
+
+  private:
+
+    Matrix matrix;
+    size_t index;
+
+  };
+
+  typedef Iterator<false> iterator;
+  typedef Iterator<true> const_iterator;
+
+  /*-------------------------------------------------------------------------*/
+
+  PointList() : points(3, 0), amount(0) {
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+  PointList(const std::vector<arma::vec>& points) :
+    points(3, points.size()), amount(0) {
+
+    for(const arma::vec& point: points) {
+      push_back(point);
+    }
+
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+  /* creates the list from serialized coordinates x0 y0 z0 x1 y1 z1 ... */
+  explicit PointList(const arma::vec& serialized) : amount(0) {
+
+    assign(serialized);
+
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+  // copies do not inherit unused capacity
+  PointList(const PointList& other) :
+    points(other.points.head_cols(other.amount)), amount(other.amount) {
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+  // the moved-from list is left empty
+  PointList(PointList&& other) :
+    points(std::move(other.points)), amount(other.amount) {
+
+    other.points.set_size(3, 0);
+    other.amount = 0;
+
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+  PointList& operator=(const PointList& other) {
+
+    if( this != &other ) {
+      this->points = other.points.head_cols(other.amount);
+      this->amount = other.amount;
+    }
+
+    return *this;
+
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+  PointList& operator=(PointList&& other) {
+
+    if( this != &other ) {
+      this->points = std::move(other.points);
+      this->amount = other.amount;
+
+      other.points.set_size(3, 0);
+      other.amount = 0;
+    }
+
+    return *this;
+
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+  /* replaces the points by serialized coordinates x0 y0 z0 x1 y1 z1 ... */
+  void assign(const arma::vec& serialized) {
+
+    if( serialized.n_elem % 3 != 0 ) {
+      throw std::runtime_error(
+        "Serialized point data is not a multiple of three.");
+    }
+
+    this->amount = serialized.n_elem / 3;
+    this->points.set_size(3, this->amount);
+
+    std::copy(serialized.begin(), serialized.end(), this->points.begin());
+
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+  size_t size() const {
+    return this->amount;
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+  bool empty() const {
+    return this->amount == 0;
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+  void clear() {
+    this->amount = 0;
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+  void reserve(const size_t& capacity) {
+
+    if( capacity > this->points.n_cols ) {
+      this->points.resize(3, capacity);
+    }
+
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+  void resize(const size_t& amount) {
+
+    reserve(amount);
+
+    if( amount > this->amount ) {
+      this->points.cols(this->amount, amount - 1).zeros();
+    }
+
+    this->amount = amount;
+
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+  void push_back(const double& x, const double& y, const double& z) {
+
+    if( this->amount == this->points.n_cols ) {
+      reserve(std::max<size_t>(16, 2 * this->amount));
+    }
+
+    double* point = this->points.colptr(this->amount);
+
+    point[0] = x;
+    point[1] = y;
+    point[2] = z;
+
+    ++this->amount;
+
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+  template<typename T>
+  void push_back(const T& point) {
+
+    push_back(point(0), point(1), point(2));
+
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+  void append(const PointList& other) {
+
+    reserve(this->amount + other.amount);
+
+    std::copy(
+      other.data(), other.data() + 3 * other.amount,
+      this->points.colptr(0) + 3 * this->amount);
+
+    this->amount += other.amount;
+
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+  /* view of the point with the given index */
+  arma::subview_col<double> operator[](const size_t& index) {
+    return this->points.col(index);
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+  // const version
+  const arma::subview_col<double> operator[](const size_t& index) const {
+    return this->points.col(index);
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+  arma::subview_col<double> at(const size_t& index) {
+    check_index(index);
+    return this->points.col(index);
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+  // const version
+  const arma::subview_col<double> at(const size_t& index) const {
+    check_index(index);
+    return this->points.col(index);
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+  /* view of all points as 3 x N matrix */
+  arma::subview<double> matrix() {
+    return this->points.head_cols(this->amount);
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+  // const version
+  const arma::subview<double> matrix() const {
+    return this->points.head_cols(this->amount);
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+  /* coordinates x0 y0 z0 x1 y1 z1 ... */
+  double* data() {
+    return this->points.memptr();
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+  const double* data() const {
+    return this->points.memptr();
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+  /* copy as separate vectors */
+  std::vector<arma::vec> to_vector() const {
+
+    std::vector<arma::vec> result;
+    result.reserve(this->amount);
+
+    for(size_t i = 0; i < this->amount; ++i) {
+      result.push_back(this->points.col(i));
+    }
+
+    return result;
+
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+  iterator begin() {
+    return iterator(&this->points, 0);
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+  iterator end() {
+    return iterator(&this->points, this->amount);
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+  const_iterator begin() const {
+    return const_iterator(&this->points, 0);
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+  const_iterator end() const {
+    return const_iterator(&this->points, this->amount);
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+private:
+
+  /*-------------------------------------------------------------------------*/
+
+  void check_index(const size_t& index) const {
+
+    if( index >= this->amount ) {
+      throw std::out_of_range("Point index out of range.");
+    }
+
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+  // the columns beyond amount are unused capacity
+  arma::mat points;
+  size_t amount;
+
+  /*-------------------------------------------------------------------------*/
+
+};
+
+#endif
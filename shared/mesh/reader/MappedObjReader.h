@@ -0,0 +1,186 @@
+/****
+   This file is part of the multilinear-model-tools.
+   These tools are meant to derive a multilinear tongue model or
+   PCA palate model from mesh data and work with it.
+
+   Some code of the multilinear-model-tools is based on
+   Timo Bolkart's work on statistical analysis of human face shapes,
+   cf. https://sites.google.com/site/bolkartt/
+
+   Copyright (C) 2016 Alexander Hewer
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+****/
+#ifndef __MAPPED_OBJ_READER_H__
+#define __MAPPED_OBJ_READER_H__
+
+#include <string>
+#include <vector>
+#include <cstring>
+
+#include <armadillo>
+
+#include "mesh/Mesh.h"
+#include "mesh/reader/MeshReader.h"
+#include "mesh/reader/TextScanner.h"
+
+#include "utility/MappedFile.h"
+
+/* reads obj files from a memory mapped file and parses the numbers in place */
+class MappedObjReader : public MeshReader {
+
+  public:
+
+    MappedObjReader() : MeshReader() {
+    }
+
+    /*-------------------------------------------------------------------------*/
+
+    const Mesh& read_mesh_from( const std::string& fileName )  {
+
+      // clear mesh
+      this->mesh = Mesh();
+
+      this->file.open_read(fileName);
+
+      const char* begin = this->file.data();
+      const char* end = begin + this->file.size();
+
+      // preallocate the flat coordinate storage of the mesh
+      this->vertices.reserve(count_lines_starting_with(begin, end, "v "));
+      this->vertexNormals.reserve(count_lines_starting_with(begin, end, "vn "));
+
+      TextScanner scanner(begin, end);
+
+      read_data(scanner);
+
+      this->file.close();
+
+      return this->mesh;
+    }
+
+    /*-------------------------------------------------------------------------*/
+
+  private:
+
+    /*-------------------------------------------------------------------------*/
+
+    static size_t count_lines_starting_with(
+      const char* begin, const char* end, const char* prefix) {
+
+      const size_t length = std::strlen(prefix);
+
+      size_t amount = 0;
+      const char* line = begin;
+
+      while( line < end ) {
+
+        if( (size_t) (end - line) >= length &&
+            std::memcmp(line, prefix, length) == 0 ) {
+          ++amount;
+        }
+
+        const void* next = std::memchr(line, '\n', end - line);
+
+        if( next == nullptr ) {
+          break;
+        }
+
+        line = static_cast<const char*>(next) + 1;
+
+      }
+
+      return amount;
+
+    }
+
+    /*-------------------------------------------------------------------------*/
+
+    void read_coordinates(
+      TextScanner& scanner, PointList& points, const std::string& what) {
+
+      double values[3];
+
+      for( int i = 0; i < 3; ++i ) {
+        if( scanner.read_double(values[i]) == false ) {
+          scanner.throw_error("Problem reading " + what);
+        }
+      }
+
+      points.push_back(values[0], values[1], values[2]);
+
+    }
+
+    /*-------------------------------------------------------------------------*/
+
+    void read_face(TextScanner& scanner) {
+
+      std::vector<unsigned int> vertexIndices;
+
+      scanner.skip_blanks();
+
+      while( scanner.at_line_end() == false ) {
+
+        long vertexId;
+
+        if( scanner.read_integer(vertexId) == false ) {
+          scanner.throw_error("Problem reading face data");
+        }
+
+        // decrement, in OBJ vertex indices start at 1
+        vertexIndices.push_back(vertexId - 1);
+
+        // discard texture and normal indices if present
+        scanner.skip_word();
+        scanner.skip_blanks();
+
+      }
+
+      this->faces.push_back(std::move(vertexIndices));
+
+    }
+
+    /*-------------------------------------------------------------------------*/
+
+    /* read data */
+    void read_data(TextScanner& scanner) {
+
+      while( scanner.at_end() == false ) {
+
+        const std::string id = scanner.read_word();
+
+        if( id == "v") {
+          // only read coordinates
+          read_coordinates(scanner, this->vertices, "vertex position");
+        }
+        else if( id == "vn") {
+          read_coordinates(scanner, this->vertexNormals, "vertex normal");
+        }
+        else if( id == "f") {
+          read_face(scanner);
+        }
+
+        scanner.skip_line();
+
+      } // while
+
+    }
+
+    /*-------------------------------------------------------------------------*/
+
+    MappedFile file;
+
+};
+#endif
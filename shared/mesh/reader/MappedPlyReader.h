@@ -0,0 +1,335 @@
+/****
+   This file is part of the multilinear-model-tools.
+   These tools are meant to derive a multilinear tongue model or
+   PCA palate model from mesh data and work with it.
+
+   Some code of the multilinear-model-tools is based on
+   Timo Bolkart's work on statistical analysis of human face shapes,
+   cf. https://sites.google.com/site/bolkartt/
+
+   Copyright (C) 2016 Alexander Hewer
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+****/
+#ifndef __MAPPED_PLY_READER_H__
+#define __MAPPED_PLY_READER_H__
+
+#include <string>
+#include <sstream>
+#include <vector>
+#include <stdexcept>
+
+#include <armadillo>
+
+#include "mesh/Mesh.h"
+#include "mesh/reader/MeshReader.h"
+#include "mesh/reader/PlyReader.h"
+#include "mesh/reader/TextScanner.h"
+
+#include "utility/MappedFile.h"
+
+/* reads ASCII ply files from a memory mapped file and parses the numbers in
+   place, binary files are handed to the PlyReader */
+class MappedPlyReader : public MeshReader {
+
+public:
+
+  MappedPlyReader() :
+    MeshReader(),
+    vertexColors(this->mesh.get_vertex_colors()),
+    vertexBoundaryMarkers(this->mesh.get_vertex_boundary_markers()),
+    faceBoundaryMarkers(this->mesh.get_face_boundary_markers()) {
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+  const Mesh& read_mesh_from(const std::string& fileName) {
+
+    // clear mesh
+    this->mesh = Mesh();
+
+    this->file.open_read(fileName);
+
+    TextScanner scanner(
+      this->file.data(), this->file.data() + this->file.size());
+
+    if( read_header(scanner) == false ) {
+
+      this->file.close();
+
+      PlyReader reader;
+      this->mesh = reader.read_mesh_from(fileName);
+
+      return this->mesh;
+
+    }
+
+    for( const Element& element: this->elements ) {
+
+      if( element.name == "vertex" ) {
+        read_vertex_data(scanner, element);
+      }
+      else if( element.name == "face" ) {
+        read_face_data(scanner, element);
+      }
+      else {
+        for( size_t i = 0; i < element.amount; ++i ) {
+          scanner.skip_line();
+        }
+      }
+
+    }
+
+    this->file.close();
+
+    return this->mesh;
+
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+private:
+
+  /*-------------------------------------------------------------------------*/
+
+  struct Element{
+    std::string name;
+    size_t amount;
+    std::vector<std::string> properties;
+  };
+
+  /*-------------------------------------------------------------------------*/
+
+  /* returns false if the file is not in ASCII format */
+  bool read_header(TextScanner& scanner) {
+
+    this->elements.clear();
+
+    if( scanner.read_line() != "ply" ) {
+      throw std::runtime_error("File is no ply file.");
+    }
+
+    bool ascii = false;
+
+    while( true ) {
+
+      if( scanner.at_end() ) {
+        throw std::runtime_error("Ply header is incomplete.");
+      }
+
+      std::stringstream line(scanner.read_line());
+
+      std::string keyword;
+      line >> keyword;
+
+      if( keyword == "end_header" ) {
+        break;
+      }
+      else if( keyword == "format" ) {
+
+        std::string format;
+        line >> format;
+
+        ascii = ( format == "ascii" );
+
+      }
+      else if( keyword == "element" ) {
+
+        Element element;
+        line >> element.name >> element.amount;
+
+        if( line.fail() ) {
+          throw std::runtime_error("Could not read element information.");
+        }
+
+        this->elements.push_back(element);
+
+      }
+      else if( keyword == "property" && this->elements.empty() == false ) {
+
+        std::string type;
+        std::string name;
+
+        line >> type;
+
+        // the vertex index list of a face is read separately
+        if( type == "list" ) {
+          continue;
+        }
+
+        line >> name;
+
+        this->elements.back().properties.push_back(name);
+
+      }
+
+    }
+
+    return ascii;
+
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+  static int find_property(const Element& element, const std::string& name) {
+
+    for( size_t i = 0; i < element.properties.size(); ++i ) {
+      if( element.properties[i] == name ) {
+        return i;
+      }
+    }
+
+    return -1;
+
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+  void read_vertex_data(TextScanner& scanner, const Element& element) {
+
+    const int x = find_property(element, "x");
+    const int y = find_property(element, "y");
+    const int z = find_property(element, "z");
+
+    if( x < 0 || y < 0 || z < 0 ) {
+      throw std::runtime_error("Ply file does not contain vertex positions.");
+    }
+
+    const int nx = find_property(element, "nx");
+    const int ny = find_property(element, "ny");
+    const int nz = find_property(element, "nz");
+    const bool hasNormals = ( nx >= 0 && ny >= 0 && nz >= 0 );
+
+    const int red = find_property(element, "red");
+    const int green = find_property(element, "green");
+    const int blue = find_property(element, "blue");
+    const bool hasColors = ( red >= 0 && green >= 0 && blue >= 0 );
+
+    const int boundary = find_property(element, "boundary");
+
+    // the coordinates are written straight into the flat mesh storage
+    this->vertices.reserve(element.amount);
+
+    if( hasNormals ) {
+      this->vertexNormals.reserve(element.amount);
+    }
+
+    if( hasColors ) {
+      this->vertexColors.reserve(element.amount);
+    }
+
+    if( boundary >= 0 ) {
+      this->vertexBoundaryMarkers.reserve(element.amount);
+    }
+
+    std::vector<double> properties(element.properties.size());
+
+    for( size_t i = 0; i < element.amount; ++i ) {
+
+      for( double& property: properties ) {
+        if( scanner.read_double(property) == false ) {
+          scanner.throw_error("Problem reading vertex properties");
+        }
+      }
+
+      scanner.skip_line();
+
+      this->vertices.push_back(properties[x], properties[y], properties[z]);
+
+      if( hasNormals ) {
+        this->vertexNormals.push_back(
+          properties[nx], properties[ny], properties[nz]);
+      }
+
+      if( hasColors ) {
+        this->vertexColors.push_back(
+          properties[red], properties[green], properties[blue]);
+      }
+
+      if( boundary >= 0 ) {
+        this->vertexBoundaryMarkers.push_back(properties[boundary]);
+      }
+
+    }
+
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+  void read_face_data(TextScanner& scanner, const Element& element) {
+
+    const int boundary = find_property(element, "boundary");
+
+    std::vector<double> properties(element.properties.size());
+
+    this->faces.reserve(element.amount);
+
+    if( boundary >= 0 ) {
+      this->faceBoundaryMarkers.reserve(element.amount);
+    }
+
+    for( size_t i = 0; i < element.amount; ++i ) {
+
+      long amount;
+
+      if( scanner.read_integer(amount) == false || amount < 0 ) {
+        scanner.throw_error("Problem reading face data");
+      }
+
+      std::vector<unsigned int> vertexIndices(amount);
+
+      for( long j = 0; j < amount; ++j ) {
+
+        long index;
+
+        if( scanner.read_integer(index) == false ) {
+          scanner.throw_error(
+            "Problem reading vertex index " + std::to_string(j) + " for face");
+        }
+
+        vertexIndices[j] = index;
+
+      }
+
+      for( double& property: properties ) {
+        if( scanner.read_double(property) == false ) {
+          scanner.throw_error("Problem reading face properties");
+        }
+      }
+
+      scanner.skip_line();
+
+      if( boundary >= 0 ) {
+        this->faceBoundaryMarkers.push_back(properties[boundary]);
+      }
+
+      this->faces.push_back(std::move(vertexIndices));
+
+    }
+
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+  PointList& vertexColors;
+  std::vector<bool>& vertexBoundaryMarkers;
+  std::vector<bool>& faceBoundaryMarkers;
+
+  std::vector<Element> elements;
+
+  MappedFile file;
+
+};
+#endif
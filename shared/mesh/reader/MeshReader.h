@@ -73,8 +73,8 @@ class MeshReader {
 
     Mesh mesh;
 
-    std::vector<arma::vec>& vertices;
-    std::vector<arma::vec>& vertexNormals;
+    PointList& vertices;
+    PointList& vertexNormals;
     std::vector< std::vector<unsigned int> >& faces;
 
     size_t lineNumber;
@@ -74,7 +74,7 @@ class ObjReader : public MeshReader {
       // only read coordinates
       stream >> x >> y >> z;
 
-      this->vertices.push_back(arma::vec({x, y, z}));
+      this->vertices.push_back(x, y, z);
 
       if( stream.fail() ) {
         throw_error("Problem reading vertex position");
@@ -90,7 +90,7 @@ class ObjReader : public MeshReader {
 
       stream >> nx >> ny >> nz;
 
-      this->vertexNormals.push_back(arma::vec({nx, ny, nz}));
+      this->vertexNormals.push_back(nx, ny, nz);
 
       if( stream.fail() ) {
         throw_error("Problem reading vertex normal");
@@ -28,9 +28,14 @@
 
 #include <string>
 #include <fstream>
+#include <sstream>
 #include <map>
+#include <vector>
+#include <cstring>
+#include <cstdint>
 #include <stdexcept>
 #include <regex>
+#include <algorithm>
 
 #include <armadillo>
 
@@ -55,7 +60,7 @@ public:
     // clear mesh
     this->mesh = Mesh();
 
-    this->meshFile.open(fileName);
+    this->meshFile.open(fileName, std::ios::in | std::ios::binary);
 
     if(this->meshFile.is_open() == false ) {
       throw std::runtime_error("Cannot open file " + fileName + ".");
@@ -64,8 +69,14 @@ public:
     this->headerEnded = false;
 
     read_header_information();
-    read_vertex_data();
-    read_face_data();
+
+    if( this->format == Format::ASCII ) {
+      read_vertex_data();
+      read_face_data();
+    }
+    else {
+      read_binary_data();
+    }
 
     this->meshFile.close();
 
@@ -79,22 +90,73 @@ private:
 
   /*-------------------------------------------------------------------------*/
 
+  enum Format{
+    ASCII,
+    BINARY_LITTLE_ENDIAN,
+    BINARY_BIG_ENDIAN
+  };
+
+  /*-------------------------------------------------------------------------*/
+
+  enum PropertyType{
+    INT8,
+    UINT8,
+    INT16,
+    UINT16,
+    INT32,
+    UINT32,
+    FLOAT32,
+    FLOAT64
+  };
+
+  /*-------------------------------------------------------------------------*/
+
+  struct Element{
+    std::string name;
+    size_t amount;
+    std::vector<PropertyType> types;
+    bool hasList;
+  };
+
+  /*-------------------------------------------------------------------------*/
+
   /* read needed header information of ply file */
   void read_header_information() {
 
     std::string read;
 
+    this->lineNumber = 0;
+
+    this->vertexPropertyIndices.clear();
+    this->vertexPropertyPresent.clear();
+    this->vertexPropertyTypes.clear();
+    this->facePropertyIndices.clear();
+    this->facePropertyPresent.clear();
+    this->facePropertyTypes.clear();
+
     // verify that we have a ply file
     read = getline();
     if( read != "ply" ) {
       throw std::runtime_error("File is no ply file.");
     }
 
-    // check that it is in ASCII format
+    // determine the storage format
     read = getline();
-    if( read != "format ascii 1.0" ) {
-      throw std::runtime_error("Only ply files in ASCII format are supported.");
+    if( read == "format ascii 1.0" ) {
+      this->format = Format::ASCII;
+    }
+    else if( read == "format binary_little_endian 1.0" ) {
+      this->format = Format::BINARY_LITTLE_ENDIAN;
     }
+    else if( read == "format binary_big_endian 1.0" ) {
+      this->format = Format::BINARY_BIG_ENDIAN;
+    }
+    else {
+      throw std::runtime_error("Unsupported ply format: " + read + ".");
+    }
+
+    // save position after the format line
+    const std::ios::pos_type pos = this->meshFile.tellg();
 
     read_vertex_information();
 
@@ -107,12 +169,68 @@ private:
       this->faceAmount = 0;
     }
 
-    // reset line number
+    // reset position and line number
+    this->meshFile.clear();
+    this->meshFile.seekg(pos);
     this->lineNumber = 2;
 
-    // move to the end of the header
-    while( this->headerEnded == false) {
-      this->headerEnded = (getline() == "end_header");
+    read_element_list();
+
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+  /* record all elements in header order and move to the end of the header */
+  void read_element_list() {
+
+    this->elements.clear();
+
+    while( true ) {
+
+      const std::string read = getline();
+
+      if( this->meshFile.fail() ) {
+        throw std::runtime_error("Ply header is incomplete.");
+      }
+
+      if( read == "end_header" ) {
+        this->headerEnded = true;
+        break;
+      }
+
+      std::stringstream line(read);
+
+      std::string keyword;
+      line >> keyword;
+
+      if( keyword == "element" ) {
+
+        Element element;
+        line >> element.name >> element.amount;
+
+        if( line.fail() ) {
+          throw std::runtime_error("Could not read element information.");
+        }
+
+        element.hasList = false;
+
+        this->elements.push_back(element);
+
+      }
+      else if( keyword == "property" && this->elements.empty() == false ) {
+
+        std::string type;
+        line >> type;
+
+        if( type == "list" ) {
+          this->elements.back().hasList = true;
+        }
+        else {
+          this->elements.back().types.push_back(parse_property_type(type));
+        }
+
+      }
+
     }
 
   }
@@ -177,7 +295,7 @@ private:
 
     this->faceAmount = find_element_count(std::string("face"));
 
-    getline();
+    read_face_list_types();
 
     read_face_property_list();
 
@@ -196,7 +314,7 @@ private:
 
     // create regular expression for property
     std::regex propertyFormat(
-      "property[[:blank:]]+(float|uchar)[[:blank:]]+([[:alpha:]]+)");
+      "property[[:blank:]]+([[:alnum:]]+)[[:blank:]]+([[:alpha:]]+)");
     std::smatch match;
 
     // extract all properties
@@ -210,6 +328,7 @@ private:
       ++index;
 
       this->vertexPropertyPresent[id] = true;
+      this->vertexPropertyTypes.push_back(parse_property_type(match[1]));
 
       tmp = getline();
     }
@@ -226,7 +345,7 @@ private:
 
     // create regular expression for property
     std::regex propertyFormat(
-      "property[[:blank:]]+(float|uchar)[[:blank:]]+([[:alpha:]]+)");
+      "property[[:blank:]]+([[:alnum:]]+)[[:blank:]]+([[:alpha:]]+)");
     std::smatch match;
 
     // extract all properties
@@ -240,6 +359,7 @@ private:
       ++index;
 
       this->facePropertyPresent[id] = true;
+      this->facePropertyTypes.push_back(parse_property_type(match[1]));
 
       tmp = getline();
     }
@@ -248,6 +368,85 @@ private:
 
   /*-------------------------------------------------------------------------*/
 
+  /* read the types of the vertex index list of a face */
+  void read_face_list_types() {
+
+    std::regex listFormat(
+      "property[[:blank:]]+list[[:blank:]]+([[:alnum:]]+)"
+      "[[:blank:]]+([[:alnum:]]+)[[:blank:]]+[[:alpha:]_]+");
+    std::smatch match;
+
+    const std::string read = getline();
+
+    if( std::regex_match(read, match, listFormat) ) {
+      this->faceCountType = parse_property_type(match[1]);
+      this->faceIndexType = parse_property_type(match[2]);
+    }
+    else {
+      this->faceCountType = PropertyType::UINT8;
+      this->faceIndexType = PropertyType::INT32;
+    }
+
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+  static PropertyType parse_property_type(const std::string& type) {
+
+    if( type == "char" || type == "int8" ) {
+      return PropertyType::INT8;
+    }
+    else if( type == "uchar" || type == "uint8" ) {
+      return PropertyType::UINT8;
+    }
+    else if( type == "short" || type == "int16" ) {
+      return PropertyType::INT16;
+    }
+    else if( type == "ushort" || type == "uint16" ) {
+      return PropertyType::UINT16;
+    }
+    else if( type == "int" || type == "int32" ) {
+      return PropertyType::INT32;
+    }
+    else if( type == "uint" || type == "uint32" ) {
+      return PropertyType::UINT32;
+    }
+    else if( type == "float" || type == "float32" ) {
+      return PropertyType::FLOAT32;
+    }
+    else if( type == "double" || type == "float64" ) {
+      return PropertyType::FLOAT64;
+    }
+
+    throw std::runtime_error("Unknown ply property type " + type + ".");
+
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+  static size_t get_type_size(const PropertyType& type) {
+
+    switch(type) {
+    case PropertyType::INT8:
+    case PropertyType::UINT8:
+      return 1;
+    case PropertyType::INT16:
+    case PropertyType::UINT16:
+      return 2;
+    case PropertyType::INT32:
+    case PropertyType::UINT32:
+    case PropertyType::FLOAT32:
+      return 4;
+    case PropertyType::FLOAT64:
+      return 8;
+    }
+
+    return 0;
+
+  }
+
+  /*-------------------------------------------------------------------------*/
+
   /* returns the index of the property with provided id */
   size_t get_vertex_property_index(
     const std::string propertyId
@@ -311,7 +510,7 @@ private:
     const double y = properties.at(get_vertex_property_index("y"));
     const double z = properties.at(get_vertex_property_index("z"));
 
-    this->vertices.push_back(arma::vec({x, y, z}));
+    this->vertices.push_back(x, y, z);
 
   }
 
@@ -328,7 +527,7 @@ private:
     const double ny = properties.at(get_vertex_property_index("ny"));
     const double nz = properties.at(get_vertex_property_index("nz"));
 
-    this->vertexNormals.push_back(arma::vec({nx, ny, nz}));
+    this->vertexNormals.push_back(nx, ny, nz);
 
   }
 
@@ -345,7 +544,7 @@ private:
     const double green = properties.at(get_vertex_property_index("green"));
     const double blue = properties.at(get_vertex_property_index("blue"));
 
-    this->vertexColors.push_back(arma::vec({red, green, blue}));
+    this->vertexColors.push_back(red, green, blue);
 
   }
 
@@ -505,7 +704,184 @@ private:
 
   /*-------------------------------------------------------------------------*/
 
-  std::vector<arma::vec>& vertexColors;
+  /* reads the remaining file at once and decodes vertices and faces from
+   * the buffer */
+  void read_binary_data() {
+
+    const std::ios::pos_type start = this->meshFile.tellg();
+    this->meshFile.seekg(0, std::ios::end);
+    const std::ios::pos_type end = this->meshFile.tellg();
+    this->meshFile.seekg(start);
+
+    this->binaryData.resize(end - start);
+    this->meshFile.read(this->binaryData.data(), this->binaryData.size());
+
+    if( this->meshFile.fail() ) {
+      throw std::runtime_error("Problem reading binary ply data.");
+    }
+
+    uint16_t probe = 1;
+    const bool hostLittleEndian = *reinterpret_cast<char*>(&probe) == 1;
+
+    this->swapBytes =
+      hostLittleEndian != (this->format == Format::BINARY_LITTLE_ENDIAN);
+
+    this->cursor = this->binaryData.data();
+    this->binaryEnd = this->binaryData.data() + this->binaryData.size();
+
+    for( const Element& element: this->elements ) {
+
+      if( element.name == "vertex" ) {
+        read_binary_vertex_data();
+      }
+      else if( element.name == "face" ) {
+        read_binary_face_data();
+      }
+      else {
+        skip_binary_element(element);
+      }
+
+    }
+
+    std::vector<char>().swap(this->binaryData);
+
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+  void read_binary_vertex_data() {
+
+    std::vector<double> properties(this->vertexPropertyTypes.size());
+
+    this->vertices.reserve(this->vertexAmount);
+
+    for( size_t i = 0; i < this->vertexAmount; ++i) {
+
+      for( size_t j = 0; j < properties.size(); ++j ) {
+        properties[j] = read_binary_value(this->vertexPropertyTypes[j]);
+      }
+
+      read_vertex_position(properties);
+      read_vertex_normal(properties);
+      read_vertex_color(properties);
+      read_vertex_boundary_marker(properties);
+
+    }
+
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+  void read_binary_face_data() {
+
+    std::vector<double> properties(this->facePropertyTypes.size());
+
+    this->faces.reserve(this->faceAmount);
+
+    for( size_t i = 0; i < this->faceAmount; ++i) {
+
+      const size_t amount = read_binary_value(this->faceCountType);
+
+      std::vector<unsigned int> vertexIndices(amount);
+
+      for( size_t j = 0; j < amount; ++j ) {
+        vertexIndices[j] = read_binary_value(this->faceIndexType);
+      }
+
+      for( size_t j = 0; j < properties.size(); ++j ) {
+        properties[j] = read_binary_value(this->facePropertyTypes[j]);
+      }
+
+      read_face_boundary_marker(properties);
+
+      this->faces.push_back(std::move(vertexIndices));
+
+    }
+
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+  /* skips an element that is not used, only possible for fixed size rows */
+  void skip_binary_element(const Element& element) {
+
+    if( element.hasList == true ) {
+      throw std::runtime_error(
+        "Cannot skip list properties of ply element " + element.name + ".");
+    }
+
+    size_t rowSize = 0;
+
+    for( const PropertyType& type: element.types ) {
+      rowSize += get_type_size(type);
+    }
+
+    const size_t size = element.amount * rowSize;
+
+    if( size > (size_t) (this->binaryEnd - this->cursor) ) {
+      throw std::runtime_error("Unexpected end of binary ply data.");
+    }
+
+    this->cursor += size;
+
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+  double read_binary_value(const PropertyType& type) {
+
+    const size_t size = get_type_size(type);
+
+    if( this->cursor + size > this->binaryEnd ) {
+      throw std::runtime_error("Unexpected end of binary ply data.");
+    }
+
+    char bytes[8];
+    std::memcpy(bytes, this->cursor, size);
+    this->cursor += size;
+
+    if( this->swapBytes == true ) {
+      std::reverse(bytes, bytes + size);
+    }
+
+    switch(type) {
+    case PropertyType::INT8:
+      return decode<int8_t>(bytes);
+    case PropertyType::UINT8:
+      return decode<uint8_t>(bytes);
+    case PropertyType::INT16:
+      return decode<int16_t>(bytes);
+    case PropertyType::UINT16:
+      return decode<uint16_t>(bytes);
+    case PropertyType::INT32:
+      return decode<int32_t>(bytes);
+    case PropertyType::UINT32:
+      return decode<uint32_t>(bytes);
+    case PropertyType::FLOAT32:
+      return decode<float>(bytes);
+    case PropertyType::FLOAT64:
+      return decode<double>(bytes);
+    }
+
+    return 0;
+
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+  template<typename T>
+  static double decode(const char* bytes) {
+
+    T value;
+    std::memcpy(&value, bytes, sizeof(T));
+
+    return value;
+
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+  PointList& vertexColors;
   std::vector<bool>& vertexBoundaryMarkers;
   std::vector<bool>& faceBoundaryMarkers;
 
@@ -515,10 +891,26 @@ private:
   std::map<std::string, bool> vertexPropertyPresent;
   std::map<std::string, bool> facePropertyPresent;
 
+  std::vector<PropertyType> vertexPropertyTypes;
+  std::vector<PropertyType> facePropertyTypes;
+
+  std::vector<Element> elements;
+
+  PropertyType faceCountType;
+  PropertyType faceIndexType;
+
   size_t vertexAmount;
   size_t faceAmount;
 
   bool headerEnded;
 
+  Format format;
+
+  // buffer for binary data
+  std::vector<char> binaryData;
+  const char* cursor;
+  const char* binaryEnd;
+  bool swapBytes;
+
 };
 #endif
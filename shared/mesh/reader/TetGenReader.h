@@ -107,7 +107,7 @@ class TetGenReader : public MeshReader {
         lineStream >> y;
         lineStream >> z;
 
-        this->vertices.push_back(arma::vec({x, y, z}));
+        this->vertices.push_back(x, y, z);
       }
 
     }
@@ -0,0 +1,376 @@
+/****
+   This file is part of the multilinear-model-tools.
+   These tools are meant to derive a multilinear tongue model or
+   PCA palate model from mesh data and work with it.
+
+   Some code of the multilinear-model-tools is based on
+   Timo Bolkart's work on statistical analysis of human face shapes,
+   cf. https://sites.google.com/site/bolkartt/
+
+   Copyright (C) 2016 Alexander Hewer
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+****/
+#ifndef __TEXT_SCANNER_H__
+#define __TEXT_SCANNER_H__
+
+#include <string>
+#include <cstdlib>
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+
+/* scans ASCII data in place, e.g. from a memory mapped file, without
+   copying lines into strings */
+class TextScanner{
+
+public:
+
+  /*-------------------------------------------------------------------------*/
+
+  TextScanner(const char* begin, const char* end) :
+    cursor(begin), end(end) {
+
+    this->lineNumber = 1;
+
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+  bool at_end() const {
+    return this->cursor >= this->end;
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+  bool at_line_end() const {
+    return at_end() || *this->cursor == '\n' || *this->cursor == '\r';
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+  const char* get_position() const {
+    return this->cursor;
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+  size_t get_line_number() const {
+    return this->lineNumber;
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+  void skip_blanks() {
+
+    while( this->cursor < this->end &&
+           ( *this->cursor == ' ' || *this->cursor == '\t' ) ) {
+      ++this->cursor;
+    }
+
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+  /* moves to the beginning of the next line */
+  void skip_line() {
+
+    while( this->cursor < this->end && *this->cursor != '\n' ) {
+      ++this->cursor;
+    }
+
+    if( this->cursor < this->end ) {
+      ++this->cursor;
+      ++this->lineNumber;
+    }
+
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+  /* skips the character sequence up to the next blank or line end */
+  void skip_word() {
+
+    while( at_line_end() == false &&
+           *this->cursor != ' ' && *this->cursor != '\t' ) {
+      ++this->cursor;
+    }
+
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+  std::string read_word() {
+
+    skip_blanks();
+
+    const char* begin = this->cursor;
+    skip_word();
+
+    return std::string(begin, this->cursor);
+
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+  /* returns the remainder of the current line and moves to the next one */
+  std::string read_line() {
+
+    const char* begin = this->cursor;
+
+    while( at_line_end() == false ) {
+      ++this->cursor;
+    }
+
+    std::string line(begin, this->cursor);
+    skip_line();
+
+    return line;
+
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+  bool read_integer(long& value) {
+
+    skip_blanks();
+
+    const char* position = this->cursor;
+    bool negative = false;
+
+    if( position < this->end && ( *position == '-' || *position == '+' ) ) {
+      negative = (*position == '-');
+      ++position;
+    }
+
+    if( position == this->end || is_digit(*position) == false ) {
+      return false;
+    }
+
+    long result = 0;
+
+    while( position < this->end && is_digit(*position) ) {
+      result = 10 * result + (*position - '0');
+      ++position;
+    }
+
+    value = ( negative ) ? -result : result;
+    this->cursor = position;
+
+    return true;
+
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+  /* decimal numbers with up to 19 significant digits and small exponents are
+     evaluated exactly with a single floating point operation, everything
+     else falls back to strtod */
+  bool read_double(double& value) {
+
+    skip_blanks();
+
+    const char* position = this->cursor;
+    bool negative = false;
+
+    if( position < this->end && ( *position == '-' || *position == '+' ) ) {
+      negative = (*position == '-');
+      ++position;
+    }
+
+    uint64_t mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+    bool anyDigit = false;
+
+    while( position < this->end && is_digit(*position) ) {
+
+      anyDigit = true;
+
+      if( digits < 19 ) {
+        mantissa = 10 * mantissa + (*position - '0');
+        if( mantissa != 0 ) {
+          ++digits;
+        }
+      }
+      else {
+        ++exponent;
+        ++digits;
+      }
+
+      ++position;
+
+    }
+
+    if( position < this->end && *position == '.' ) {
+
+      ++position;
+
+      while( position < this->end && is_digit(*position) ) {
+
+        anyDigit = true;
+
+        if( digits < 19 ) {
+          mantissa = 10 * mantissa + (*position - '0');
+          --exponent;
+          if( mantissa != 0 ) {
+            ++digits;
+          }
+        }
+        else {
+          ++digits;
+        }
+
+        ++position;
+
+      }
+
+    }
+
+    if( anyDigit == false ) {
+      // inf, nan and malformed input
+      return read_double_fallback(value);
+    }
+
+    if( position < this->end && ( *position == 'e' || *position == 'E' ) ) {
+
+      const char* exponentStart = position;
+      ++position;
+
+      bool negativeExponent = false;
+
+      if( position < this->end && ( *position == '-' || *position == '+' ) ) {
+        negativeExponent = (*position == '-');
+        ++position;
+      }
+
+      if( position == this->end || is_digit(*position) == false ) {
+        // no exponent, 'e' belongs to the next token
+        position = exponentStart;
+      }
+      else {
+
+        int explicitExponent = 0;
+
+        while( position < this->end && is_digit(*position) ) {
+          if( explicitExponent < 100000 ) {
+            explicitExponent = 10 * explicitExponent + (*position - '0');
+          }
+          ++position;
+        }
+
+        exponent += ( negativeExponent ) ? -explicitExponent : explicitExponent;
+
+      }
+
+    }
+
+    // exact if the mantissa fits into the double precision significand
+    if( digits > 19 || mantissa > (uint64_t(1) << 53) ||
+        exponent < -22 || exponent > 22 ) {
+      return read_double_fallback(value);
+    }
+
+    double result = mantissa;
+
+    if( exponent < 0 ) {
+      result /= powers_of_ten()[-exponent];
+    }
+    else {
+      result *= powers_of_ten()[exponent];
+    }
+
+    value = ( negative ) ? -result : result;
+    this->cursor = position;
+
+    return true;
+
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+  void throw_error(const std::string& what) const {
+
+    throw std::runtime_error(
+      what + " at line " + std::to_string(this->lineNumber));
+
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+private:
+
+  /*-------------------------------------------------------------------------*/
+
+  static bool is_digit(const char& character) {
+    return character >= '0' && character <= '9';
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+  static const double* powers_of_ten() {
+
+    static const double powers[] = {
+      1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+      1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    return powers;
+
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+  /* strtod needs a terminated string, the mapped data is not terminated */
+  bool read_double_fallback(double& value) {
+
+    const char* begin = this->cursor;
+    const char* tokenEnd = begin;
+
+    while( tokenEnd < this->end && tokenEnd - begin < 63 &&
+           *tokenEnd != ' ' && *tokenEnd != '\t' &&
+           *tokenEnd != '\n' && *tokenEnd != '\r' ) {
+      ++tokenEnd;
+    }
+
+    char token[64];
+    std::copy(begin, tokenEnd, token);
+    token[tokenEnd - begin] = '\0';
+
+    char* parsedEnd = nullptr;
+    value = std::strtod(token, &parsedEnd);
+
+    if( parsedEnd == token ) {
+      return false;
+    }
+
+    this->cursor = begin + (parsedEnd - token);
+
+    return true;
+
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+  const char* cursor;
+  const char* end;
+
+  size_t lineNumber;
+
+  /*-------------------------------------------------------------------------*/
+
+};
+
+#endif
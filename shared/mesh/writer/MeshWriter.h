@@ -59,8 +59,8 @@ class MeshWriter{
 
   protected:
 
-    const std::vector<arma::vec>& vertices;
-    const std::vector<arma::vec>& vertexNormals;
+    const PointList& vertices;
+    const PointList& vertexNormals;
     const std::vector<bool>& vertexBoundaryMarkers;
     const std::vector< std::vector<unsigned int> > faces;
     const std::vector<bool> faceBoundaryMarkers;
@@ -29,6 +29,10 @@
 #include <string>
 #include <fstream>
 #include <map>
+#include <vector>
+#include <cstring>
+#include <cstdint>
+#include <algorithm>
 #include <stdexcept>
 #include <regex>
 
@@ -40,20 +44,45 @@
 class PlyWriter : public MeshWriter {
   public:
 
-    PlyWriter(const Mesh& mesh) :
+    enum Format{
+      ASCII,
+      BINARY_LITTLE_ENDIAN,
+      BINARY_BIG_ENDIAN
+    };
+
+    /*-------------------------------------------------------------------------*/
+
+    PlyWriter(const Mesh& mesh, const Format& format = Format::ASCII) :
       MeshWriter(mesh),
-      vertexColors(mesh.get_vertex_colors()) {
+      vertexColors(mesh.get_vertex_colors()),
+      format(format) {
+    }
+
+    /*-------------------------------------------------------------------------*/
+
+    void set_format(const Format& format) {
+      this->format = format;
     }
 
     /*-------------------------------------------------------------------------*/
 
     void write_mesh_to( const std::string& fileName) {
 
-      this->meshFile.open(fileName);
+      this->meshFile.open(fileName, std::ios::out | std::ios::binary);
+
+      if( this->meshFile.is_open() == false ) {
+        throw std::runtime_error("Cannot open file " + fileName + ".");
+      }
 
       write_header_information();
-      write_vertex_data();
-      write_face_data();
+
+      if( this->format == Format::ASCII ) {
+        write_vertex_data();
+        write_face_data();
+      }
+      else {
+        write_binary_data();
+      }
 
       this->meshFile.close();
 
@@ -70,14 +99,24 @@ class PlyWriter : public MeshWriter {
 
       std::string read; 
 
-      this->meshFile << "ply" << std::endl;
-      this->meshFile << "format ascii 1.0" << std::endl;
+      this->meshFile << "ply" << '\n';
+      switch(this->format) {
+      case Format::ASCII:
+        this->meshFile << "format ascii 1.0" << '\n';
+        break;
+      case Format::BINARY_LITTLE_ENDIAN:
+        this->meshFile << "format binary_little_endian 1.0" << '\n';
+        break;
+      case Format::BINARY_BIG_ENDIAN:
+        this->meshFile << "format binary_big_endian 1.0" << '\n';
+        break;
+      }
 
       write_comments();
       write_vertex_information();
       write_face_information();
 
-      this->meshFile << "end_header" << std::endl;
+      this->meshFile << "end_header" << '\n';
 
     }
 
@@ -86,7 +125,7 @@ class PlyWriter : public MeshWriter {
     void write_comments() {
 
       for( const auto& comment: this->comments ) {
-        this->meshFile << "comment " << comment << std::endl;
+        this->meshFile << "comment " << comment << '\n';
       }
 
     }
@@ -96,25 +135,25 @@ class PlyWriter : public MeshWriter {
     /* write vertex amount and property list to header */
     void write_vertex_information() {
 
-      this->meshFile << "element vertex "  << this->vertices.size() << std::endl;
-      this->meshFile << "property float x" << std::endl;
-      this->meshFile << "property float y" << std::endl;
-      this->meshFile << "property float z" << std::endl;
+      this->meshFile << "element vertex "  << this->vertices.size() << '\n';
+      this->meshFile << "property float x" << '\n';
+      this->meshFile << "property float y" << '\n';
+      this->meshFile << "property float z" << '\n';
 
       if( this->vertexNormals.empty() == false ) {
-        this->meshFile << "property float nx" << std::endl;
-        this->meshFile << "property float ny" << std::endl;
-        this->meshFile << "property float nz" << std::endl;
+        this->meshFile << "property float nx" << '\n';
+        this->meshFile << "property float ny" << '\n';
+        this->meshFile << "property float nz" << '\n';
       }
 
       if( this->vertexColors.empty() == false ) {
-        this->meshFile << "property uchar red" << std::endl;
-        this->meshFile << "property uchar green" << std::endl;
-        this->meshFile << "property uchar blue" << std::endl;
+        this->meshFile << "property uchar red" << '\n';
+        this->meshFile << "property uchar green" << '\n';
+        this->meshFile << "property uchar blue" << '\n';
       }
 
       if( this->vertexBoundaryMarkers.empty() == false) {
-        this->meshFile << "property float boundary" << std::endl;
+        this->meshFile << "property float boundary" << '\n';
       }
 
     }
@@ -125,11 +164,11 @@ class PlyWriter : public MeshWriter {
     void write_face_information() {
 
       if( this->faces.size() > 0 ) {
-        this->meshFile << "element face " << this->faces.size() << std::endl;
-        this->meshFile << "property list uchar uint vertex_indices" << std::endl;
+        this->meshFile << "element face " << this->faces.size() << '\n';
+        this->meshFile << "property list uchar uint vertex_indices" << '\n';
 
         if( this->faceBoundaryMarkers.empty() == false) {
-          this->meshFile << "property float boundary" << std::endl;
+          this->meshFile << "property float boundary" << '\n';
         }
 
 
@@ -205,7 +244,7 @@ class PlyWriter : public MeshWriter {
         write_vertex_color(i);
         write_vertex_boundary_marker(i);
 
-        this->meshFile << std::endl;
+        this->meshFile << '\n';
 
       }
     }
@@ -233,7 +272,7 @@ class PlyWriter : public MeshWriter {
           this->meshFile << marker;
         }
 
-        this->meshFile << std::endl;
+        this->meshFile << '\n';
       }
 
 
@@ -241,7 +280,96 @@ class PlyWriter : public MeshWriter {
 
     /*-------------------------------------------------------------------------*/
 
-    const std::vector<arma::vec>& vertexColors;
+    /* assembles the vertex and face blocks in one buffer that is written
+     * at once, the property types match the header */
+    void write_binary_data() {
+
+      uint16_t probe = 1;
+      const bool hostLittleEndian = *reinterpret_cast<char*>(&probe) == 1;
+
+      this->swapBytes =
+        hostLittleEndian != (this->format == Format::BINARY_LITTLE_ENDIAN);
+
+      this->binaryData.clear();
+      this->binaryData.reserve(
+        this->vertices.size() * 4 * 10 + this->faces.size() * 17);
+
+      for( size_t i = 0; i < this->vertices.size(); ++i) {
+
+        const arma::vec& v = this->vertices.at(i);
+
+        append<float>(v(0));
+        append<float>(v(1));
+        append<float>(v(2));
+
+        if( this->vertexNormals.empty() == false ) {
+          const arma::vec& vn = this->vertexNormals.at(i);
+
+          append<float>(vn(0));
+          append<float>(vn(1));
+          append<float>(vn(2));
+        }
+
+        if( this->vertexColors.empty() == false ) {
+          const arma::vec& vc = this->vertexColors.at(i);
+
+          append<uint8_t>(vc(0));
+          append<uint8_t>(vc(1));
+          append<uint8_t>(vc(2));
+        }
+
+        if( this->vertexBoundaryMarkers.empty() == false ) {
+          append<float>(this->vertexBoundaryMarkers.at(i));
+        }
+
+      }
+
+      for( size_t i = 0; i < this->faces.size(); ++i) {
+
+        const std::vector<unsigned int>& vertexIndices = this->faces.at(i);
+
+        append<uint8_t>(vertexIndices.size());
+
+        for( const auto& index: vertexIndices) {
+          append<uint32_t>(index);
+        }
+
+        if( this->faceBoundaryMarkers.empty() == false ) {
+          append<float>(this->faceBoundaryMarkers.at(i));
+        }
+
+      }
+
+      this->meshFile.write(this->binaryData.data(), this->binaryData.size());
+
+    }
+
+    /*-------------------------------------------------------------------------*/
+
+    template<typename T>
+    void append(const double& value) {
+
+      const T converted = static_cast<T>(value);
+
+      char bytes[sizeof(T)];
+      std::memcpy(bytes, &converted, sizeof(T));
+
+      if( this->swapBytes == true ) {
+        std::reverse(bytes, bytes + sizeof(T));
+      }
+
+      this->binaryData.insert(this->binaryData.end(), bytes, bytes + sizeof(T));
+
+    }
+
+    /*-------------------------------------------------------------------------*/
+
+    const PointList& vertexColors;
+
+    Format format;
+
+    std::vector<char> binaryData;
+    bool swapBytes;
 
 
 };
@@ -0,0 +1,231 @@
+/****
+   This file is part of the multilinear-model-tools.
+   These tools are meant to derive a multilinear tongue model or
+   PCA palate model from mesh data and work with it.
+
+   Some code of the multilinear-model-tools is based on
+   Timo Bolkart's work on statistical analysis of human face shapes,
+   cf. https://sites.google.com/site/bolkartt/
+
+   Copyright (C) 2016 Alexander Hewer
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+****/
+#ifndef __BINARY_MODEL_FORMAT_H__
+#define __BINARY_MODEL_FORMAT_H__
+
+#include <string>
+#include <fstream>
+#include <cstring>
+#include <cstdint>
+#include <stdexcept>
+
+/* layout of binary model files
+ *
+ * the file starts with a header followed by the raw arrays
+ *
+ *   core tensor          speaker x phoneme x vertex scalars
+ *   speaker mean weights speaker scalars
+ *   phoneme mean weights phoneme scalars
+ *   shape space origin   vertex scalars
+ *   face offsets         faceAmount + 1 uint32 values
+ *   face indices         faceIndexAmount uint32 values
+ *
+ * the indices of face i are stored in [offsets[i], offsets[i + 1]),
+ * scalars are float64 or float32, all values use the byte order of the
+ * writing machine and every array starts at a multiple of the alignment
+ */
+class BinaryModelFormat{
+
+public:
+
+  /*--------------------------------------------------------------------------*/
+
+  class Header{
+
+  public:
+
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint32_t scalarSize;
+
+    int32_t originalSpeakerModeDimension;
+    int32_t originalPhonemeModeDimension;
+    int32_t speakerModeDimension;
+    int32_t phonemeModeDimension;
+    int32_t vertexModeDimension;
+
+    uint64_t faceAmount;
+    uint64_t faceIndexAmount;
+
+  };
+
+  /*--------------------------------------------------------------------------*/
+
+  /* byte offsets of the arrays inside the file */
+  class Layout{
+
+  public:
+
+    size_t coreTensor;
+    size_t speakerMeanWeights;
+    size_t phonemeMeanWeights;
+    size_t origin;
+    size_t faceOffsets;
+    size_t faceIndices;
+
+    size_t fileSize;
+
+  };
+
+  /*--------------------------------------------------------------------------*/
+
+  static Header create_header() {
+
+    Header header;
+
+    std::memset(&header, 0, sizeof(Header));
+    std::memcpy(header.magic, magic(), sizeof(header.magic));
+
+    header.version = version;
+    header.byteOrder = byteOrderMark;
+    header.scalarSize = sizeof(double);
+
+    return header;
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  /* checks the header and whether the file is large enough for the arrays */
+  static void validate(const Header& header, const size_t& fileSize) {
+
+    if( std::memcmp(header.magic, magic(), sizeof(header.magic)) != 0 ) {
+      throw std::runtime_error("File is not a binary model.");
+    }
+
+    if( header.byteOrder != byteOrderMark ) {
+      throw std::runtime_error("Binary model was written with another byte order.");
+    }
+
+    if( header.version != version ) {
+      throw std::runtime_error("Binary model version is not supported.");
+    }
+
+    if( header.scalarSize != sizeof(double) &&
+        header.scalarSize != sizeof(float) ) {
+      throw std::runtime_error("Binary model scalar size is not supported.");
+    }
+
+    if( header.speakerModeDimension <= 0 ||
+        header.phonemeModeDimension <= 0 ||
+        header.vertexModeDimension <= 0 ||
+        header.vertexModeDimension % 3 != 0 ) {
+      throw std::runtime_error("Binary model has invalid dimensions.");
+    }
+
+    if( layout_of(header).fileSize > fileSize ) {
+      throw std::runtime_error("Binary model file is truncated.");
+    }
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  static Layout layout_of(const Header& header) {
+
+    const size_t scalarSize = header.scalarSize;
+
+    const size_t coreTensorSize =
+      (size_t) header.speakerModeDimension * header.phonemeModeDimension *
+      header.vertexModeDimension;
+
+    Layout layout;
+
+    layout.coreTensor = align(sizeof(Header));
+    layout.speakerMeanWeights =
+      align(layout.coreTensor + scalarSize * coreTensorSize);
+    layout.phonemeMeanWeights =
+      align(layout.speakerMeanWeights +
+            scalarSize * header.speakerModeDimension);
+    layout.origin =
+      align(layout.phonemeMeanWeights +
+            scalarSize * header.phonemeModeDimension);
+    layout.faceOffsets =
+      align(layout.origin + scalarSize * header.vertexModeDimension);
+    layout.faceIndices =
+      align(layout.faceOffsets +
+            sizeof(uint32_t) * ( header.faceAmount + 1 ));
+
+    layout.fileSize =
+      layout.faceIndices + sizeof(uint32_t) * header.faceIndexAmount;
+
+    return layout;
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  /* checks the magic bytes at the beginning of the file */
+  static bool is_binary_model(const std::string& fileName) {
+
+    std::ifstream file(fileName, std::ios::binary);
+
+    char bytes[sizeof(Header::magic)] = {0};
+
+    file.read(bytes, sizeof(bytes));
+
+    return file.good() &&
+      std::memcmp(bytes, magic(), sizeof(bytes)) == 0;
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+private:
+
+  /*--------------------------------------------------------------------------*/
+
+  // eight bytes including the terminating zero
+  static const char* magic() {
+
+    return "MLMODEL";
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  static size_t align(const size_t& offset) {
+
+    return ( offset + alignment - 1 ) / alignment * alignment;
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  static const uint32_t version = 1;
+
+  // reads as another value on machines with a different byte order
+  static const uint32_t byteOrderMark = 0x01020304;
+
+  // arrays start at cache line boundaries
+  static const size_t alignment = 64;
+
+  /*--------------------------------------------------------------------------*/
+
+};
+
+#endif
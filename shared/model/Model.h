@@ -70,7 +70,8 @@ public:
     this->modelMeshReconstructor = new
       ModelMeshReconstructor(this->modelData, *this->modelReconstructor);
 
-    this->modelDerivative = new ModelDerivative(*this->modelSpace);
+    this->modelDerivative =
+      new ModelDerivative(this->modelData, *this->modelSpace);
 
     this->modelTruncator =
       new ModelTruncator(this->modelData, *this->modelSpace);
@@ -125,7 +126,8 @@ public:
     this->modelMeshReconstructor = new
       ModelMeshReconstructor(this->modelData, *this->modelReconstructor);
 
-    this->modelDerivative = new ModelDerivative(*this->modelSpace);
+    this->modelDerivative =
+      new ModelDerivative(this->modelData, *this->modelSpace);
 
     this->modelTruncator =
       new ModelTruncator(this->modelData, *this->modelSpace);
@@ -153,7 +155,8 @@ public:
     this->modelMeshReconstructor = new
       ModelMeshReconstructor(this->modelData, *this->modelReconstructor);
 
-    this->modelDerivative = new ModelDerivative(*this->modelSpace);
+    this->modelDerivative =
+      new ModelDerivative(this->modelData, *this->modelSpace);
 
     this->modelTruncator =
       new ModelTruncator(this->modelData, *this->modelSpace);
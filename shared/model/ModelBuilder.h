@@ -52,6 +52,8 @@ public:
     this->originSet = false;
     this->facesSet = false;
 
+    this->decompositionMethod = TensorAnalysis::DecompositionMethod::SVD;
+
   }
 
   /*--------------------------------------------------------------------------*/
@@ -115,6 +117,15 @@ public:
 
   /*--------------------------------------------------------------------------*/
 
+  void set_decomposition_method(
+    const TensorAnalysis::DecompositionMethod& method) {
+
+    this->decompositionMethod = method;
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
 
   Model build() {
 
@@ -125,6 +136,8 @@ public:
 
     TensorAnalysis analysis(this->tensor);
 
+    analysis.set_decomposition_method(this->decompositionMethod);
+
     analysis.set_truncated_mode_one_dimension(
       this->truncatedSpeakerModeDimension
       );
@@ -199,6 +212,8 @@ private:
   int truncatedSpeakerModeDimension;
   int truncatedPhonemeModeDimension;
 
+  TensorAnalysis::DecompositionMethod decompositionMethod;
+
   /*--------------------------------------------------------------------------*/
 
 };
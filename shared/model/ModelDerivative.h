@@ -28,13 +28,20 @@
 
 #include <armadillo>
 
+#include "model/ModelData.h"
+#include "model/ModelSpace.h"
+#include "model/ModelJacobian.h"
+
 class ModelDerivative{
 
 public:
 
   /*--------------------------------------------------------------------------*/
 
-  ModelDerivative(const ModelSpace& modelSpace) : space(modelSpace) {
+  ModelDerivative(
+    const ModelData& modelData,
+    const ModelSpace& modelSpace) :
+    modelData(modelData), space(modelSpace) {
   }
 
   /*--------------------------------------------------------------------------*/
@@ -49,6 +56,15 @@ public:
 
   /*--------------------------------------------------------------------------*/
 
+  // version of speaker() that writes into the provided matrix
+  void speaker(const arma::vec& phonemeWeights, arma::mat& result) const {
+
+    this->space.phoneme(phonemeWeights, result);
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
   // columns of returned matrix correspond to derivatives with respect to
   // the phoneme weights
   arma::mat phoneme(const arma::vec& speakerWeights) const {
@@ -59,10 +75,31 @@ public:
 
   /*--------------------------------------------------------------------------*/
 
+  // version of phoneme() that writes into the provided matrix
+  void phoneme(const arma::vec& speakerWeights, arma::mat& result) const {
+
+    this->space.speaker(speakerWeights, result);
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  /* returns a derivative cache that can be restricted to a subset of
+   * vertices and is only recomputed if the weights change
+   */
+  ModelJacobian jacobian() const {
+
+    return ModelJacobian(this->modelData, this->space);
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
 private:
 
   /*--------------------------------------------------------------------------*/
 
+  const ModelData& modelData;
   const ModelSpace& space;
 
   /*--------------------------------------------------------------------------*/
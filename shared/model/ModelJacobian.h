@@ -0,0 +1,182 @@
+/****
+   This file is part of the multilinear-model-tools.
+   These tools are meant to derive a multilinear tongue model or
+   PCA palate model from mesh data and work with it.
+
+   Some code of the multilinear-model-tools is based on
+   Timo Bolkart's work on statistical analysis of human face shapes,
+   cf. https://sites.google.com/site/bolkartt/
+
+   Copyright (C) 2016 Alexander Hewer
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+****/
+#ifndef __MODEL_JACOBIAN_H__
+#define __MODEL_JACOBIAN_H__
+
+#include <vector>
+
+#include <armadillo>
+
+#include "model/ModelData.h"
+#include "model/ModelSpace.h"
+#include "model/ModelRowView.h"
+#include "model/ModelPrecision.h"
+
+/* derivative of the model restricted to a selection of its vertices
+ *
+ * the derivatives are computed on a ModelRowView and only recomputed if
+ * the weights change
+ */
+class ModelJacobian{
+
+public:
+
+  /*--------------------------------------------------------------------------*/
+
+  ModelJacobian(
+    const ModelData& modelData,
+    const ModelSpace& modelSpace) :
+    modelData(modelData), view(modelData, modelSpace) {
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  /* selects the vertices the derivatives are computed for,
+   * the rows of the derivatives follow the order of the provided indices
+   */
+  void set_vertex_indices(const std::vector<int>& vertexIndices) {
+
+    if( this->view.set_vertex_indices(vertexIndices) == true ) {
+
+      // cached derivatives are no longer valid
+      this->speakerWeights.reset();
+      this->phonemeWeights.reset();
+
+    }
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  /* recomputes the derivatives if the weights changed */
+  void update(
+    const arma::vec& speakerWeights,
+    const arma::vec& phonemeWeights
+    ) {
+
+    const int rowAmount = this->view.get_row_indices().n_elem;
+
+    // derivative with respect to the phoneme weights depends on the speaker
+    // weights only
+    if( is_equal(speakerWeights, this->speakerWeights) == false ) {
+
+      this->phonemeDerivative.set_size(
+        rowAmount, this->modelData.get_phoneme_mode_dimension());
+
+      arma::vec linearized(
+        this->phonemeDerivative.memptr(),
+        this->phonemeDerivative.n_elem, false, true);
+
+      ModelPrecision::multiply(
+        this->view.get_model_speaker(), speakerWeights, linearized);
+
+      this->speakerWeights = speakerWeights;
+
+    }
+
+    // derivative with respect to the speaker weights depends on the phoneme
+    // weights only
+    if( is_equal(phonemeWeights, this->phonemeWeights) == false ) {
+
+      this->speakerDerivative.set_size(
+        rowAmount, this->modelData.get_speaker_mode_dimension());
+
+      arma::vec linearized(
+        this->speakerDerivative.memptr(),
+        this->speakerDerivative.n_elem, false, true);
+
+      ModelPrecision::multiply(
+        this->view.get_model_phoneme(), phonemeWeights, linearized);
+
+      this->phonemeWeights = phonemeWeights;
+
+    }
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  // columns of returned matrix correspond to derivatives with respect to
+  // the speaker weights
+  const arma::mat& speaker() const {
+    return this->speakerDerivative;
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  // columns of returned matrix correspond to derivatives with respect to
+  // the phoneme weights
+  const arma::mat& phoneme() const {
+    return this->phonemeDerivative;
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  // restricted view of the model the derivatives are computed with
+  const ModelRowView& rows() const {
+    return this->view;
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+private:
+
+  /*--------------------------------------------------------------------------*/
+
+  static bool is_equal(const arma::vec& a, const arma::vec& b) {
+
+    if( a.n_elem != b.n_elem ) {
+      return false;
+    }
+
+    for(unsigned int i = 0; i < a.n_elem; ++i) {
+      if( a(i) != b(i) ) {
+        return false;
+      }
+    }
+
+    return true;
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  const ModelData& modelData;
+
+  ModelRowView view;
+
+  // weights the cached derivatives were computed for
+  arma::vec speakerWeights;
+  arma::vec phonemeWeights;
+
+  arma::mat speakerDerivative;
+  arma::mat phonemeDerivative;
+
+  /*--------------------------------------------------------------------------*/
+
+};
+
+#endif
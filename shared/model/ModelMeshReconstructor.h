@@ -51,9 +51,36 @@ public:
     const arma::vec& phonemeWeights
     ) const {
 
-    return build_mesh(
-      this->reconstruct.for_weights(speakerWeights, phonemeWeights)
-      );
+    Mesh result;
+
+    for_weights(speakerWeights, phonemeWeights, result);
+
+    return result;
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  /* version of for_weights() that reconstructs into the provided mesh
+   *
+   * the topology of the shape space origin mesh is only copied if the mesh
+   * does not have it yet, otherwise just its vertex buffer is overwritten:
+   * passing the result of a previous call avoids copying the faces
+   */
+  void for_weights(
+    const arma::vec& speakerWeights,
+    const arma::vec& phonemeWeights,
+    Mesh& result
+    ) const {
+
+    reuse_topology(result);
+
+    // the reconstruction has the layout of the vertex storage
+    arma::vec values(
+      result.get_vertices().data(), 3 * result.get_vertex_amount(),
+      false, true);
+
+    this->reconstruct.for_weights(speakerWeights, phonemeWeights, values);
 
   }
 
@@ -78,22 +105,32 @@ private:
 
   Mesh build_mesh(const arma::vec values) const {
 
-    std::vector<arma::vec> vertices;
-
-    for(unsigned int i = 0; i < values.n_rows; i+=3) {
-      arma::vec vertex({ values(i), values(i+1), values(i+2) });
-      vertices.push_back(vertex);
-    }
-
     Mesh result = this->modelData.get_shape_space_origin_mesh();
 
-    result.set_vertices(vertices);
+    // the reconstruction already has the layout of the vertex storage
+    result.get_vertices().assign(values);
 
     return result;
   }
 
   /*--------------------------------------------------------------------------*/
 
+  /* copies the origin mesh into the result if its vertex or face amount
+   * differs, the topology of the origin mesh is immutable
+   */
+  void reuse_topology(Mesh& result) const {
+
+    const Mesh& origin = this->modelData.get_shape_space_origin_mesh();
+
+    if( result.get_vertex_amount() != origin.get_vertex_amount() ||
+        result.get_face_amount() != origin.get_face_amount() ) {
+      result = origin;
+    }
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
   const ModelData& modelData;
   const ModelReconstructor& reconstruct;
 
@@ -0,0 +1,98 @@
+/****
+   This file is part of the multilinear-model-tools.
+   These tools are meant to derive a multilinear tongue model or
+   PCA palate model from mesh data and work with it.
+
+   Some code of the multilinear-model-tools is based on
+   Timo Bolkart's work on statistical analysis of human face shapes,
+   cf. https://sites.google.com/site/bolkartt/
+
+   Copyright (C) 2016 Alexander Hewer
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+****/
+#ifndef __MODEL_PRECISION_H__
+#define __MODEL_PRECISION_H__
+
+#include <armadillo>
+
+/* scalar type of the model basis matrices used for reconstruction and
+ * derivatives, weights, origins and results stay in double precision
+ *
+ * single precision is selected by defining MODEL_SINGLE_PRECISION,
+ * cf. the MODEL_SINGLE_PRECISION option of the CMake projects
+ */
+#ifdef MODEL_SINGLE_PRECISION
+typedef float ModelScalar;
+#else
+typedef double ModelScalar;
+#endif
+
+typedef arma::Mat<ModelScalar> ModelMatrix;
+
+/* products of model basis matrices with double precision operands,
+ * the product is evaluated in the precision of the basis
+ */
+class ModelPrecision{
+
+public:
+
+  /*--------------------------------------------------------------------------*/
+
+  // result = matrix * x
+  template<typename T>
+  static void multiply(const arma::mat& matrix, const T& x, T& result) {
+
+    result = matrix * x;
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  // single precision version
+  template<typename T>
+  static void multiply(const arma::fmat& matrix, const T& x, T& result) {
+
+    const arma::fmat product = matrix * arma::conv_to<arma::fmat>::from(x);
+    result = arma::conv_to<T>::from(product);
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  // result += matrix * x
+  template<typename T>
+  static void multiply_add(const arma::mat& matrix, const T& x, T& result) {
+
+    result += matrix * x;
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  // single precision version
+  template<typename T>
+  static void multiply_add(const arma::fmat& matrix, const T& x, T& result) {
+
+    const arma::fmat product = matrix * arma::conv_to<arma::fmat>::from(x);
+    result += arma::conv_to<T>::from(product);
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+};
+
+#endif
@@ -27,6 +27,9 @@
 #define __MODEL_READER_H__
 
 #include <vector>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
 
 #include <yaml-cpp/yaml.h>
 
@@ -36,8 +39,11 @@
 #include "model/Model.h"
 #include "model/ModelData.h"
 
+#include "model/BinaryModelFormat.h"
+
 #include "utility/Serializer.h"
 #include "utility/BinaryConverter.h"
+#include "utility/MappedFile.h"
 
 class ModelReader{
 
@@ -45,8 +51,16 @@ public:
 
   /*--------------------------------------------------------------------------*/
 
+  /* reads binary models and YAML models, the format is detected from the
+   * beginning of the file
+   */
   ModelReader(const std::string& fileName) {
 
+    if( BinaryModelFormat::is_binary_model(fileName) == true ) {
+      read_binary_model(fileName);
+      return;
+    }
+
     this->modelFile = YAML::LoadFile(fileName);
 
     read_dimensions();
@@ -188,6 +202,122 @@ private:
 
   /*--------------------------------------------------------------------------*/
 
+  /* the arrays of the mapped file are copied in bulk, no values are parsed */
+  void read_binary_model(const std::string& fileName) {
+
+    MappedFile file;
+    file.open_read(fileName);
+
+    if( file.size() < sizeof(BinaryModelFormat::Header) ) {
+      throw std::runtime_error("Binary model file is truncated.");
+    }
+
+    BinaryModelFormat::Header header;
+    std::memcpy(&header, file.data(), sizeof(header));
+
+    BinaryModelFormat::validate(header, file.size());
+
+    const BinaryModelFormat::Layout layout =
+      BinaryModelFormat::layout_of(header);
+
+    this->dimensionOriginalSpeakerMode = header.originalSpeakerModeDimension;
+    this->dimensionOriginalPhonemeMode = header.originalPhonemeModeDimension;
+    this->dimensionSpeakerMode = header.speakerModeDimension;
+    this->dimensionPhonemeMode = header.phonemeModeDimension;
+    this->dimensionVertexMode = header.vertexModeDimension;
+
+    const size_t& scalarSize = header.scalarSize;
+
+    this->coreTensorData.resize(
+      (size_t) this->dimensionSpeakerMode * this->dimensionPhonemeMode *
+      this->dimensionVertexMode);
+
+    read_scalars(
+      file.data() + layout.coreTensor, scalarSize,
+      this->coreTensorData.size(), this->coreTensorData.data());
+
+    this->speakerMeanWeights.set_size(this->dimensionSpeakerMode);
+    read_scalars(
+      file.data() + layout.speakerMeanWeights, scalarSize,
+      this->speakerMeanWeights.n_elem, this->speakerMeanWeights.memptr());
+
+    this->phonemeMeanWeights.set_size(this->dimensionPhonemeMode);
+    read_scalars(
+      file.data() + layout.phonemeMeanWeights, scalarSize,
+      this->phonemeMeanWeights.n_elem, this->phonemeMeanWeights.memptr());
+
+    this->origin.set_size(this->dimensionVertexMode);
+    read_scalars(
+      file.data() + layout.origin, scalarSize,
+      this->origin.n_elem, this->origin.memptr());
+
+    read_binary_faces(file, header, layout);
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  void read_binary_faces(
+    const MappedFile& file,
+    const BinaryModelFormat::Header& header,
+    const BinaryModelFormat::Layout& layout) {
+
+    std::vector<uint32_t> offsets(header.faceAmount + 1);
+    std::vector<uint32_t> indices(header.faceIndexAmount);
+
+    std::memcpy(
+      offsets.data(), file.data() + layout.faceOffsets,
+      sizeof(uint32_t) * offsets.size());
+
+    std::memcpy(
+      indices.data(), file.data() + layout.faceIndices,
+      sizeof(uint32_t) * indices.size());
+
+    const uint32_t vertexAmount = this->dimensionVertexMode / 3;
+
+    if( offsets.front() != 0 || offsets.back() != indices.size() ||
+        std::is_sorted(offsets.begin(), offsets.end()) == false ) {
+      throw std::runtime_error("Binary model has invalid face offsets.");
+    }
+
+    for(const uint32_t& index: indices) {
+      if( index >= vertexAmount ) {
+        throw std::runtime_error("Binary model has invalid face indices.");
+      }
+    }
+
+    this->faces.clear();
+    this->faces.reserve(header.faceAmount);
+
+    for(size_t i = 0; i < header.faceAmount; ++i) {
+      this->faces.push_back(std::vector<unsigned int>(
+          indices.begin() + offsets[i], indices.begin() + offsets[i + 1]));
+    }
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  /* copies float64 values or widens float32 values */
+  static void read_scalars(
+    const char* source, const size_t& scalarSize,
+    const size_t& amount, double* target) {
+
+    if( scalarSize == sizeof(double) ) {
+      std::memcpy(target, source, sizeof(double) * amount);
+      return;
+    }
+
+    for(size_t i = 0; i < amount; ++i) {
+      float value;
+      std::memcpy(&value, source + sizeof(float) * i, sizeof(float));
+      target[i] = value;
+    }
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
   Mesh build_origin_shape_mesh() const {
 
     Mesh mesh;
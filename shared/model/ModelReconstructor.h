@@ -27,6 +27,7 @@
 #define __MODEL_RECONSTRUCTOR_H__
 
 #include <vector>
+#include <stdexcept>
 
 #include <armadillo>
 
@@ -54,13 +55,108 @@ public:
     const arma::vec& phonemeWeights
     ) const {
 
-    const arma::mat speaker =
-      this->space.speaker(speakerWeights);
+    arma::vec result;
 
-    const arma::vec& origin = this->modelData.get_shape_space_origin();
+    for_weights(speakerWeights, phonemeWeights, result);
 
-    const arma::vec result =
-      speaker * phonemeWeights + origin;
+    return result;
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  /* version of for_weights() that writes into the provided vector
+   *
+   * the bilinear form core x_1 speakerWeights x_2 phonemeWeights is evaluated
+   * directly: the outer product of both weight vectors is contracted with the
+   * mode three unfolding of the core tensor in a single GEMV, such that the
+   * vertexDimension x phonemeDimension speaker space is never formed
+   */
+  void for_weights(
+    const arma::vec& speakerWeights,
+    const arma::vec& phonemeWeights,
+    arma::vec& result
+    ) const {
+
+    // get dimensions
+    const int& dimensionVertexMode =
+      this->modelData.get_vertex_mode_dimension();
+
+    const int& dimensionSpeakerMode =
+      this->modelData.get_speaker_mode_dimension();
+
+    const int& dimensionPhonemeMode =
+      this->modelData.get_phoneme_mode_dimension();
+
+    // entry i * phonemeDimension + j contains speakerWeights(i) * phonemeWeights(j)
+    const arma::vec coefficients = arma::kron(speakerWeights, phonemeWeights);
+
+    // mode three unfolding of the core tensor without copying it
+    const ModelMatrix unfolding(
+      const_cast<ModelScalar*>(this->space.get_model_speaker().memptr()),
+      dimensionVertexMode,
+      dimensionSpeakerMode * dimensionPhonemeMode,
+      false, true
+      );
+
+    result = this->modelData.get_shape_space_origin();
+    ModelPrecision::multiply_add(unfolding, coefficients, result);
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  /* reconstructs a whole sequence of weights at once
+   *
+   * column f of speakerWeights and phonemeWeights contains the weights of
+   * frame f, column f of the returned vertexDimension x frameAmount matrix
+   * contains the corresponding reconstruction
+   *
+   * all frames are computed with one GEMM against the mode three unfolding
+   * of the core tensor
+   */
+  arma::mat for_weight_batch(
+    const arma::mat& speakerWeights,
+    const arma::mat& phonemeWeights
+    ) const {
+
+    if( speakerWeights.n_cols != phonemeWeights.n_cols ) {
+      throw std::runtime_error(
+        "Amount of speaker and phoneme weight frames does not match.");
+    }
+
+    // get dimensions
+    const int& dimensionVertexMode =
+      this->modelData.get_vertex_mode_dimension();
+
+    const int& dimensionSpeakerMode =
+      this->modelData.get_speaker_mode_dimension();
+
+    const int& dimensionPhonemeMode =
+      this->modelData.get_phoneme_mode_dimension();
+
+    const int frameAmount = speakerWeights.n_cols;
+
+    // column f contains the outer product of the weights of frame f
+    arma::mat coefficients(
+      dimensionSpeakerMode * dimensionPhonemeMode, frameAmount);
+
+    for(int f = 0; f < frameAmount; ++f) {
+      coefficients.col(f) =
+        arma::kron(speakerWeights.col(f), phonemeWeights.col(f));
+    }
+
+    // mode three unfolding of the core tensor without copying it
+    const ModelMatrix unfolding(
+      const_cast<ModelScalar*>(this->space.get_model_speaker().memptr()),
+      dimensionVertexMode,
+      dimensionSpeakerMode * dimensionPhonemeMode,
+      false, true
+      );
+
+    arma::mat result;
+    ModelPrecision::multiply(unfolding, coefficients, result);
+    result.each_col() += this->modelData.get_shape_space_origin();
 
     return result;
 
@@ -0,0 +1,200 @@
+/****
+   This file is part of the multilinear-model-tools.
+   These tools are meant to derive a multilinear tongue model or
+   PCA palate model from mesh data and work with it.
+
+   Some code of the multilinear-model-tools is based on
+   Timo Bolkart's work on statistical analysis of human face shapes,
+   cf. https://sites.google.com/site/bolkartt/
+
+   Copyright (C) 2016 Alexander Hewer
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+****/
+#ifndef __MODEL_ROW_VIEW_H__
+#define __MODEL_ROW_VIEW_H__
+
+#include <vector>
+
+#include <armadillo>
+
+#include "model/ModelData.h"
+#include "model/ModelSpace.h"
+#include "model/ModelPrecision.h"
+
+/* view of the model restricted to a selection of its vertices
+ *
+ * only the rows of the model space and the shape space origin that belong
+ * to the selected vertices are gathered, the model itself is not copied
+ */
+class ModelRowView{
+
+public:
+
+  /*--------------------------------------------------------------------------*/
+
+  ModelRowView(
+    const ModelData& modelData,
+    const ModelSpace& modelSpace) :
+    modelData(modelData), space(modelSpace) {
+
+    // start without any selected vertices
+    set_vertex_indices(std::vector<int>());
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  /* selects the vertices of the view, the rows of the view follow the order
+   * of the provided indices
+   *
+   * returns false if the selection did not change
+   */
+  bool set_vertex_indices(const std::vector<int>& vertexIndices) {
+
+    // gathered rows are still valid
+    if( vertexIndices == this->vertexIndices &&
+        this->modelSpeaker.n_cols ==
+        (unsigned int) this->modelData.get_speaker_mode_dimension() ) {
+      return false;
+    }
+
+    this->vertexIndices = vertexIndices;
+
+    // get dimensions
+    const int& dimensionVertexMode =
+      this->modelData.get_vertex_mode_dimension();
+
+    const int& dimensionSpeakerMode =
+      this->modelData.get_speaker_mode_dimension();
+
+    const int& dimensionPhonemeMode =
+      this->modelData.get_phoneme_mode_dimension();
+
+    const int rowAmount = 3 * vertexIndices.size();
+
+    // rows of the linearized vertex data belonging to the selected vertices
+    this->rowIndices.set_size(rowAmount);
+
+    for(size_t i = 0; i < vertexIndices.size(); ++i) {
+      for(int j = 0; j < 3; ++j) {
+        this->rowIndices(3 * i + j) = 3 * vertexIndices.at(i) + j;
+      }
+    }
+
+    // gather the corresponding rows of every slice of the model space
+    arma::uvec speakerRows(rowAmount * dimensionPhonemeMode);
+
+    for(int j = 0; j < dimensionPhonemeMode; ++j) {
+      for(int r = 0; r < rowAmount; ++r) {
+        speakerRows(j * rowAmount + r) =
+          this->rowIndices(r) + j * dimensionVertexMode;
+      }
+    }
+
+    arma::uvec phonemeRows(rowAmount * dimensionSpeakerMode);
+
+    for(int i = 0; i < dimensionSpeakerMode; ++i) {
+      for(int r = 0; r < rowAmount; ++r) {
+        phonemeRows(i * rowAmount + r) =
+          this->rowIndices(r) + i * dimensionVertexMode;
+      }
+    }
+
+    this->modelSpeaker = this->space.get_model_speaker().rows(speakerRows);
+    this->modelPhoneme = this->space.get_model_phoneme().rows(phonemeRows);
+    this->origin =
+      this->modelData.get_shape_space_origin().elem(this->rowIndices);
+
+    return true;
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  /* reconstructs the selected vertices only, entries 3 * i to 3 * i + 2 of
+   * the result belong to the i-th selected vertex
+   */
+  void for_weights(
+    const arma::vec& speakerWeights,
+    const arma::vec& phonemeWeights,
+    arma::vec& result
+    ) const {
+
+    // entry i * phonemeDimension + j contains speakerWeights(i) * phonemeWeights(j)
+    const arma::vec coefficients = arma::kron(speakerWeights, phonemeWeights);
+
+    // the gathered speaker rows form the restricted mode three unfolding
+    const ModelMatrix unfolding(
+      const_cast<ModelScalar*>(this->modelSpeaker.memptr()),
+      this->rowIndices.n_elem,
+      coefficients.n_elem,
+      false, true
+      );
+
+    result = this->origin;
+    ModelPrecision::multiply_add(unfolding, coefficients, result);
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  // restricted version of ModelSpace::get_model_speaker()
+  const ModelMatrix& get_model_speaker() const {
+    return this->modelSpeaker;
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  // restricted version of ModelSpace::get_model_phoneme()
+  const ModelMatrix& get_model_phoneme() const {
+    return this->modelPhoneme;
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  const std::vector<int>& get_vertex_indices() const {
+    return this->vertexIndices;
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  // rows of the linearized vertex data the view consists of
+  const arma::uvec& get_row_indices() const {
+    return this->rowIndices;
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+private:
+
+  /*--------------------------------------------------------------------------*/
+
+  const ModelData& modelData;
+  const ModelSpace& space;
+
+  std::vector<int> vertexIndices;
+  arma::uvec rowIndices;
+
+  // rows of the model space matrices and the origin of the selected vertices
+  ModelMatrix modelSpeaker;
+  ModelMatrix modelPhoneme;
+  arma::vec origin;
+
+  /*--------------------------------------------------------------------------*/
+
+};
+
+#endif
@@ -27,10 +27,12 @@
 #define __MODEL_SPACE_H__
 
 #include <vector>
+#include <algorithm>
 
 #include <armadillo>
 
 #include "model/ModelData.h"
+#include "model/ModelPrecision.h"
 
 class ModelSpace{
 
@@ -56,6 +58,20 @@ public:
   // use speaker weights to remove this degree of freedom
   arma::mat speaker(const arma::vec& speakerWeights) const {
 
+    arma::mat result;
+
+    speaker(speakerWeights, result);
+
+    return result;
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  // version of speaker() that writes into the provided matrix,
+  // no memory is allocated if the matrix already has the correct size
+  void speaker(const arma::vec& speakerWeights, arma::mat& result) const {
+
     // get dimensions
     const int& dimensionVertexMode =
       this->modelData.get_vertex_mode_dimension();
@@ -63,15 +79,11 @@ public:
     const int& dimensionPhonemeMode =
       this->modelData.get_phoneme_mode_dimension();
 
-    arma::mat speaker(
-      dimensionVertexMode,
-      dimensionPhonemeMode, arma::fill::zeros);
-
-    for(unsigned int i = 0; i < modelSpeaker.size(); ++i) {
-      speaker += speakerWeights(i) * modelSpeaker.at(i);
-    }
+    result.set_size(dimensionVertexMode, dimensionPhonemeMode);
 
-    return speaker;
+    // view the result as one long vector -> contraction is a single GEMV
+    arma::vec linearized(result.memptr(), result.n_elem, false, true);
+    ModelPrecision::multiply(this->modelSpeaker, speakerWeights, linearized);
 
   }
 
@@ -80,47 +92,44 @@ public:
   // use phoneme weights to remove this degree of freedom
   arma::mat phoneme(const arma::vec& phonemeWeights) const {
 
-    // get dimensions
-    const int& dimensionVertexMode =
-      this->modelData.get_vertex_mode_dimension();
+    arma::mat result;
 
-    const int& dimensionSpeakerMode =
-      this->modelData.get_speaker_mode_dimension();
+    phoneme(phonemeWeights, result);
 
-    arma::mat phoneme(
-      dimensionVertexMode,
-      dimensionSpeakerMode, arma::fill::zeros);
-
-    // generate space
-    for(unsigned int i = 0; i < modelPhoneme.size(); ++i) {
-      phoneme += phonemeWeights(i) * this->modelPhoneme.at(i);
-    }
-
-    return phoneme;
+    return result;
 
   }
 
   /*--------------------------------------------------------------------------*/
 
-  void set_model_speaker(const std::vector<arma::mat>& modelSpeaker) {
-    this->modelSpeaker = modelSpeaker;
-  }
+  // version of phoneme() that writes into the provided matrix,
+  // no memory is allocated if the matrix already has the correct size
+  void phoneme(const arma::vec& phonemeWeights, arma::mat& result) const {
 
-  /*--------------------------------------------------------------------------*/
+    // get dimensions
+    const int& dimensionVertexMode =
+      this->modelData.get_vertex_mode_dimension();
+
+    const int& dimensionSpeakerMode =
+      this->modelData.get_speaker_mode_dimension();
+
+    result.set_size(dimensionVertexMode, dimensionSpeakerMode);
+
+    // view the result as one long vector -> contraction is a single GEMV
+    arma::vec linearized(result.memptr(), result.n_elem, false, true);
+    ModelPrecision::multiply(this->modelPhoneme, phonemeWeights, linearized);
 
-  void set_model_phoneme(const std::vector<arma::mat>& modelPhoneme) {
-    this->modelPhoneme = modelPhoneme;
   }
 
   /*--------------------------------------------------------------------------*/
 
-  const std::vector<arma::mat>& get_model_speaker() const {
+  const ModelMatrix& get_model_speaker() const {
     return this->modelSpeaker;
   }
 
   /*--------------------------------------------------------------------------*/
 
-  const std::vector<arma::mat>& get_model_phoneme() const {
+  const ModelMatrix& get_model_phoneme() const {
     return this->modelPhoneme;
   }
 
@@ -132,9 +141,23 @@ private:
 
   void generate_model_speaker() {
 
-    this->modelSpeaker =
-      this->modelData.get_core_tensor().modes().\
-      get_mode_three_matrices_along_mode_one();
+    const TensorData& data = this->modelData.get_core_tensor().data();
+
+    const int& dimensionSpeakerMode = data.get_mode_one_dimension();
+    const int& dimensionPhonemeMode = data.get_mode_two_dimension();
+    const int& dimensionVertexMode = data.get_mode_three_dimension();
+
+    this->modelSpeaker.set_size(
+      dimensionVertexMode * dimensionPhonemeMode,
+      dimensionSpeakerMode
+      );
+
+    // the core tensor is stored with the vertex mode running fastest,
+    // so its raw data already has the wanted layout
+    std::copy(
+      data.get_data().begin(), data.get_data().end(),
+      this->modelSpeaker.begin()
+      );
 
   }
 
@@ -142,9 +165,33 @@ private:
 
   void generate_model_phoneme() {
 
-    this->modelPhoneme =
-      this->modelData.get_core_tensor().modes().\
-      get_mode_three_matrices_along_mode_two();
+    const TensorData& data = this->modelData.get_core_tensor().data();
+
+    const int& dimensionSpeakerMode = data.get_mode_one_dimension();
+    const int& dimensionPhonemeMode = data.get_mode_two_dimension();
+    const int& dimensionVertexMode = data.get_mode_three_dimension();
+
+    this->modelPhoneme.set_size(
+      dimensionVertexMode * dimensionSpeakerMode,
+      dimensionPhonemeMode
+      );
+
+    const double* source = data.get_data().data();
+
+    // copy vertex mode fibers: fiber (i, j) becomes block i of column j
+    for(int i = 0; i < dimensionSpeakerMode; ++i) {
+      for(int j = 0; j < dimensionPhonemeMode; ++j) {
+
+        const double* fiber =
+          source + ( i * dimensionPhonemeMode + j ) * dimensionVertexMode;
+
+        std::copy(
+          fiber, fiber + dimensionVertexMode,
+          this->modelPhoneme.colptr(j) + i * dimensionVertexMode
+          );
+
+      } // end for j
+    } // end for i
 
   }
 
@@ -152,11 +199,15 @@ private:
 
   const ModelData& modelData;
 
-  // vector of vertexModeDimension x phonemeModeDimension matrices
-  std::vector<arma::mat> modelSpeaker;
+  // (vertexModeDimension * phonemeModeDimension) x speakerModeDimension matrix,
+  // column i holds the vertexModeDimension x phonemeModeDimension slice
+  // belonging to speaker i in column-major order
+  ModelMatrix modelSpeaker;
 
-  // vector of vertexModeDimension x speakerModeDimension matrices
-  std::vector<arma::mat> modelPhoneme;
+  // (vertexModeDimension * speakerModeDimension) x phonemeModeDimension matrix,
+  // column j holds the vertexModeDimension x speakerModeDimension slice
+  // belonging to phoneme j in column-major order
+  ModelMatrix modelPhoneme;
 
   /*--------------------------------------------------------------------------*/
 
@@ -26,7 +26,20 @@
 #ifndef __MODEL_WRITER_H__
 #define __MODEL_WRITER_H__
 
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstring>
+#include <cstdint>
+#include <stdexcept>
+
+#include <yaml-cpp/yaml.h>
+
+#include "model/Model.h"
+#include "model/BinaryModelFormat.h"
+
 #include "utility/BinaryConverter.h"
+#include "utility/MappedFile.h"
 
 class ModelWriter{
 
@@ -34,42 +47,195 @@ public:
 
   /*--------------------------------------------------------------------------*/
 
-  ModelWriter(const Model& model) : model(model) {
+  enum Format{
+    // YAML with base64 encoded core tensor
+    TEXT,
+    // binary model with float64 arrays
+    BINARY,
+    // binary model with float32 arrays, halves the file size
+    BINARY_SINGLE
+  };
+
+  /*--------------------------------------------------------------------------*/
+
+  ModelWriter(const Model& model, const Format& format = Format::TEXT) :
+    model(model), format(format), mightyEmitter(nullptr) {
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  /* format for the names yaml, binary and binary32 */
+  static Format format_from_name(const std::string& name) {
+
+    if( name == "yaml" ) {
+      return Format::TEXT;
+    }
+    else if( name == "binary" ) {
+      return Format::BINARY;
+    }
+    else if( name == "binary32" ) {
+      return Format::BINARY_SINGLE;
+    }
+
+    throw std::runtime_error("Unknown model format: " + name + ".");
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  ModelWriter& set_format(const Format& format) {
+
+    this->format = format;
+    return *this;
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  void write(const std::string& fileName) {
+
+    if( this->format == Format::TEXT ) {
+      write_yaml(fileName);
+    }
+    else {
+      write_binary(fileName);
+    }
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+private:
+
+  /*--------------------------------------------------------------------------*/
+
+  void write_yaml(const std::string& fileName) {
+
+    YAML::Emitter emitter;
+    this->mightyEmitter = &emitter;
 
     // start the map
-    this->mightyEmitter << YAML::BeginMap;
+    emitter << YAML::BeginMap;
 
     output_dimensions();
     output_core_tensor();
     output_mean_weights();
     output_shape_space_information();
 
-    this->mightyEmitter << YAML::EndMap;
+    emitter << YAML::EndMap;
 
+    std::ofstream outFile(fileName);
+    outFile << emitter.c_str();
+    outFile.close();
+
+    this->mightyEmitter = nullptr;
 
   }
 
   /*--------------------------------------------------------------------------*/
 
-  void write(const std::string& fileName) {
+  /* the arrays are copied into the mapped output file */
+  void write_binary(const std::string& fileName) {
 
-    std::ofstream outFile(fileName);
-    outFile << this->mightyEmitter.c_str();
-    outFile.close();
+    const ModelData& data = this->model.data();
+
+    const std::vector< std::vector<unsigned int> >& faces =
+      data.get_shape_space_origin_mesh().get_faces();
+
+    BinaryModelFormat::Header header = BinaryModelFormat::create_header();
+
+    header.scalarSize =
+      ( this->format == Format::BINARY_SINGLE )? sizeof(float): sizeof(double);
+
+    header.originalSpeakerModeDimension =
+      data.get_original_speaker_mode_dimension();
+    header.originalPhonemeModeDimension =
+      data.get_original_phoneme_mode_dimension();
+    header.speakerModeDimension = data.get_speaker_mode_dimension();
+    header.phonemeModeDimension = data.get_phoneme_mode_dimension();
+    header.vertexModeDimension = data.get_vertex_mode_dimension();
+
+    header.faceAmount = faces.size();
+    header.faceIndexAmount = 0;
+
+    for(const std::vector<unsigned int>& face: faces) {
+      header.faceIndexAmount += face.size();
+    }
+
+    const BinaryModelFormat::Layout layout =
+      BinaryModelFormat::layout_of(header);
+
+    MappedFile file;
+    file.create(fileName, layout.fileSize);
+
+    std::memcpy(file.data(), &header, sizeof(header));
+
+    const std::vector<double>& coreTensor =
+      data.get_core_tensor().data().get_data();
 
-    // output core tensor
-//    out << YAML::Key << "CoreTensor";
+    write_scalars(
+      coreTensor.data(), coreTensor.size(), header.scalarSize,
+      file.data() + layout.coreTensor);
 
-//    out << YAML::Value << YAML::Flow << YAML::BeginSeq;
-    //   for(const double& value: coreTensor) { out << value; }
-    // out << YAML::EndSeq;
+    write_scalars(
+      data.get_speaker_mean_weights().memptr(),
+      data.get_speaker_mean_weights().n_elem, header.scalarSize,
+      file.data() + layout.speakerMeanWeights);
 
+    write_scalars(
+      data.get_phoneme_mean_weights().memptr(),
+      data.get_phoneme_mean_weights().n_elem, header.scalarSize,
+      file.data() + layout.phonemeMeanWeights);
+
+    write_scalars(
+      data.get_shape_space_origin().memptr(),
+      data.get_shape_space_origin().n_elem, header.scalarSize,
+      file.data() + layout.origin);
+
+    char* offset = file.data() + layout.faceOffsets;
+    char* index = file.data() + layout.faceIndices;
+
+    uint32_t position = 0;
+
+    for(const std::vector<unsigned int>& face: faces) {
+
+      std::memcpy(offset, &position, sizeof(uint32_t));
+      offset += sizeof(uint32_t);
+
+      for(const unsigned int& vertex: face) {
+        const uint32_t value = vertex;
+        std::memcpy(index, &value, sizeof(uint32_t));
+        index += sizeof(uint32_t);
+      }
+
+      position += face.size();
+
+    }
+
+    std::memcpy(offset, &position, sizeof(uint32_t));
+
+    file.close();
 
   }
 
   /*--------------------------------------------------------------------------*/
 
-private:
+  /* copies float64 values or narrows them to float32 */
+  static void write_scalars(
+    const double* source, const size_t& amount,
+    const size_t& scalarSize, char* target) {
+
+    if( scalarSize == sizeof(double) ) {
+      std::memcpy(target, source, sizeof(double) * amount);
+      return;
+    }
+
+    for(size_t i = 0; i < amount; ++i) {
+      const float value = source[i];
+      std::memcpy(target + sizeof(float) * i, &value, sizeof(float));
+    }
+
+  }
 
   /*--------------------------------------------------------------------------*/
 
@@ -88,7 +254,7 @@ private:
     const int dimensionOriginalPhonemeMode =
       this->model.data().get_original_phoneme_mode_dimension();
 
-    this->mightyEmitter << YAML::Key << "Dimensions"
+    *this->mightyEmitter << YAML::Key << "Dimensions"
                         << YAML::Value << YAML::BeginMap
 
                         << YAML::Key << "OriginalSpeakerMode"
@@ -122,7 +288,7 @@ private:
     unsigned char* bytes =
       BinaryConverter::convert_to_bytes(coreTensor, size);
 
-    this->mightyEmitter << YAML::Key << "CoreTensor"
+    *this->mightyEmitter << YAML::Key << "CoreTensor"
                         << YAML::Value << YAML::Binary(bytes, size);
 
     delete[] bytes;
@@ -138,24 +304,24 @@ private:
     const arma::vec& speakerMean =
       this->model.data().get_speaker_mean_weights();
 
-    this->mightyEmitter << YAML::Key << "MeanWeights"
+    *this->mightyEmitter << YAML::Key << "MeanWeights"
                         << YAML::Value << YAML::BeginMap
                         << YAML::Key << "SpeakerMode"
                         << YAML::Value << YAML::Flow << YAML::BeginSeq;
 
     for(const double& value: speakerMean) {
-      this->mightyEmitter << value;
+      *this->mightyEmitter << value;
     }
 
-    this->mightyEmitter << YAML::EndSeq
+    *this->mightyEmitter << YAML::EndSeq
                         << YAML::Key << "PhonemeMode"
                         << YAML::Value << YAML::Flow << YAML::BeginSeq;
 
     for(const double& value: phonemeMean) {
-      this->mightyEmitter << value;
+      *this->mightyEmitter << value;
     }
 
-    this->mightyEmitter << YAML::EndSeq
+    *this->mightyEmitter << YAML::EndSeq
                         << YAML::EndMap;
 
   } // end output_mean_weights
@@ -169,31 +335,31 @@ private:
     const std::vector< std::vector< unsigned int > >& faces =
       this->model.data().get_shape_space_origin_mesh().get_faces();
 
-    this->mightyEmitter << YAML::Key << "ShapeSpace"
+    *this->mightyEmitter << YAML::Key << "ShapeSpace"
                         << YAML::Value << YAML::BeginMap
                         << YAML::Key << "Origin"
                         << YAML::Value << YAML::Flow << YAML::BeginSeq;
 
     for(const double& value: origin) {
-      this->mightyEmitter << value;
+      *this->mightyEmitter << value;
     }
 
-    this->mightyEmitter << YAML::EndSeq
+    *this->mightyEmitter << YAML::EndSeq
                         << YAML::Key << "Faces"
                         << YAML::Value << YAML::Flow << YAML::BeginSeq;
 
     for(const auto& face: faces) {
-      this->mightyEmitter << YAML::Flow << YAML::BeginSeq;
+      *this->mightyEmitter << YAML::Flow << YAML::BeginSeq;
 
       for( const unsigned index: face) {
-        this->mightyEmitter << index;
+        *this->mightyEmitter << index;
       } // end for face
 
-      this->mightyEmitter << YAML::EndSeq;
+      *this->mightyEmitter << YAML::EndSeq;
 
     } // end for faces
 
-    this->mightyEmitter << YAML::EndSeq
+    *this->mightyEmitter << YAML::EndSeq
                         << YAML::EndMap;
 
 
@@ -202,7 +368,10 @@ private:
   /*--------------------------------------------------------------------------*/
 
   const Model& model;
-  YAML::Emitter mightyEmitter;
+  Format format;
+
+  // only set while the YAML model is written
+  YAML::Emitter* mightyEmitter;
 
   /*--------------------------------------------------------------------------*/
 
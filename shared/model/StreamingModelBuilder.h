@@ -0,0 +1,429 @@
+/****
+   This file is part of the multilinear-model-tools.
+   These tools are meant to derive a multilinear tongue model or
+   PCA palate model from mesh data and work with it.
+
+   Some code of the multilinear-model-tools is based on
+   Timo Bolkart's work on statistical analysis of human face shapes,
+   cf. https://sites.google.com/site/bolkartt/
+
+   Copyright (C) 2016 Alexander Hewer
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+****/
+#ifndef __STREAMING_MODEL_BUILDER_H__
+#define __STREAMING_MODEL_BUILDER_H__
+
+#include <cstdio>
+#include <map>
+#include <set>
+#include <string>
+#include <limits>
+#include <vector>
+#include <stdexcept>
+
+#include <armadillo>
+#include <yaml-cpp/yaml.h>
+
+#include "mesh/Mesh.h"
+#include "mesh/MeshIO.h"
+
+#include "model/ModelData.h"
+#include "model/Model.h"
+
+#include "tensor/Tensor.h"
+#include "tensor/TensorAnalysis.h"
+
+#include "utility/MappedFile.h"
+#include "utility/Serializer.h"
+
+/* Builds a model directly from a sample file without holding more than one
+   training mesh in memory. The centered data is never formed: the meshes
+   are stored once in tensor layout (optionally in a memory mapped spill file)
+   and the Gram matrices of the speaker and phoneme unfoldings are derived
+   from the inner products of the samples. */
+class StreamingModelBuilder{
+
+public:
+
+  /*--------------------------------------------------------------------------*/
+
+  StreamingModelBuilder() {
+
+    this->samplesSet = false;
+    this->spill = false;
+
+    this->truncateSpeaker = false;
+    this->truncatePhoneme = false;
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  void set_samples(const std::string& fileName) {
+
+    this->samplesFile = fileName;
+    this->samplesSet = true;
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  void set_spill_file(const std::string& fileName) {
+
+    this->spillFile = fileName;
+    this->spill = true;
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  void set_truncated_speaker_mode_dimension(const int& truncatedDimension) {
+
+    this->truncatedSpeakerModeDimension = truncatedDimension;
+    this->truncateSpeaker = true;
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  void set_truncated_phoneme_mode_dimension(const int& truncatedDimension) {
+
+    this->truncatedPhonemeModeDimension = truncatedDimension;
+    this->truncatePhoneme = true;
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  Model build() {
+
+    if( this->samplesSet == false ) {
+
+      throw std::logic_error(
+        "Can not build model. Necessary data is not present.");
+
+    }
+
+    read_sample_list();
+    stream_samples();
+    compute_mode_matrices();
+
+    ModelData modelData;
+    modelData.set_core_tensor(compute_core_tensor())                 \
+      .set_shape_space_origin(this->origin)                          \
+      .set_shape_space_origin_mesh(this->originMesh)                 \
+      .set_speaker_mean_weights(
+        (arma::sum(this->speakerU, 0) / this->speakerU.n_rows).t())  \
+      .set_phoneme_mean_weights(
+        (arma::sum(this->phonemeU, 0) / this->phonemeU.n_rows).t())  \
+      .set_original_speaker_mode_dimension(this->speakerAmount)      \
+      .set_original_phoneme_mode_dimension(this->phonemeAmount);
+
+    release_storage();
+
+    return Model(modelData);
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+private:
+
+  /*--------------------------------------------------------------------------*/
+
+  // only reads the file names, the meshes are loaded while streaming
+  void read_sample_list() {
+
+    this->paths.clear();
+
+    std::set<std::string> speakers;
+    std::set<std::string> phonemes;
+
+    YAML::Node training = YAML::LoadFile(this->samplesFile);
+
+    for(const YAML::Node& speaker: training["data"]) {
+
+      std::string speakerId = speaker["name"].as<std::string>();
+      speakers.insert(speakerId);
+
+      for(const YAML::Node& phoneme: speaker["phonemes"]) {
+
+        std::string phonemeId = phoneme["prompt"].as<std::string>();
+        phonemes.insert(phonemeId);
+
+        this->paths[speakerId][phonemeId] = phoneme["path"].as<std::string>();
+
+      } // end phoneme
+    } // end speaker
+
+    // same ordering as the in-memory training data
+    this->sampleFiles.clear();
+
+    for(const std::string& speakerId: speakers) {
+      for(const std::string& phonemeId: phonemes) {
+
+        if( this->paths[speakerId].count(phonemeId) == 0 ) {
+          throw std::runtime_error(
+            "Missing mesh for speaker " + speakerId +
+            " and phoneme " + phonemeId + ".");
+        }
+
+        this->sampleFiles.push_back(this->paths[speakerId][phonemeId]);
+
+      }
+    }
+
+    this->speakerAmount = speakers.size();
+    this->phonemeAmount = phonemes.size();
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  // stores every sample relative to the first one: centering is invariant
+  // under this shift and the inner products stay well conditioned
+  void stream_samples() {
+
+    const int sampleAmount = this->sampleFiles.size();
+
+    this->innerProducts = arma::zeros(sampleAmount, sampleAmount);
+
+    for(int sample = 0; sample < sampleAmount; ++sample) {
+
+      Mesh mesh = MeshIO::read(this->sampleFiles.at(sample));
+      arma::vec vector = Serializer::serialize(mesh.get_vertices());
+
+      if( sample == 0 ) {
+
+        this->reference = vector;
+        this->faces = mesh.get_faces();
+        this->runningMean = arma::zeros(vector.n_elem);
+
+        allocate_storage(vector.n_elem, sampleAmount);
+
+      }
+      else if( vector.n_elem != this->reference.n_elem ) {
+
+        throw std::runtime_error(
+          "Mesh " + this->sampleFiles.at(sample) +
+          " has a different vertex amount.");
+
+      }
+
+      arma::vec shifted(
+        this->storage + (size_t) sample * this->spaceSize, this->spaceSize,
+        false, true);
+
+      shifted = vector - this->reference;
+
+      this->runningMean += (shifted - this->runningMean) / (sample + 1);
+
+      // inner products with all samples stored so far
+      const arma::mat stored(
+        this->storage, this->spaceSize, sample + 1, false, true);
+
+      const arma::vec products = stored.t() * shifted;
+
+      this->innerProducts(arma::span(0, sample), sample) = products;
+      this->innerProducts(sample, arma::span(0, sample)) = products.t();
+
+    } // end for sample
+
+    this->origin = this->reference + this->runningMean;
+
+    this->originMesh.set_vertices(Serializer::unserialize(this->origin));
+    this->originMesh.set_faces(this->faces);
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  void allocate_storage(const int& spaceSize, const int& sampleAmount) {
+
+    this->spaceSize = spaceSize;
+
+    const size_t size = (size_t) spaceSize * sampleAmount;
+
+    // the storage is viewed as one matrix holding all samples
+    if( size > std::numeric_limits<arma::uword>::max() ) {
+      throw std::runtime_error(
+        "Training data exceeds the index range of Armadillo.");
+    }
+
+    if( this->spill == true ) {
+
+      this->spillStorage.create(this->spillFile, size * sizeof(double));
+      this->storage = reinterpret_cast<double*>(this->spillStorage.data());
+
+    }
+    else {
+
+      this->memoryStorage.assign(size, 0);
+      this->storage = this->memoryStorage.data();
+
+    }
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  void release_storage() {
+
+    if( this->spill == true ) {
+
+      this->spillStorage.close();
+      std::remove(this->spillFile.c_str());
+
+    }
+
+    std::vector<double>().swap(this->memoryStorage);
+    this->storage = nullptr;
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  // centers the inner products algebraically and sums them up to the Gram
+  // matrices of the speaker and phoneme unfoldings
+  void compute_mode_matrices() {
+
+    const int sampleAmount = this->innerProducts.n_rows;
+
+    const arma::vec rowMeans = arma::mean(this->innerProducts, 1);
+    const double totalMean = arma::mean(rowMeans);
+
+    arma::mat centered = this->innerProducts;
+    centered.each_col() -= rowMeans;
+    centered.each_row() -= rowMeans.t();
+    centered += totalMean;
+
+    arma::mat speakerGram = arma::zeros(this->speakerAmount, this->speakerAmount);
+    arma::mat phonemeGram = arma::zeros(this->phonemeAmount, this->phonemeAmount);
+
+    for(int first = 0; first < sampleAmount; ++first) {
+      for(int second = 0; second < sampleAmount; ++second) {
+
+        const int firstSpeaker = first / this->phonemeAmount;
+        const int firstPhoneme = first % this->phonemeAmount;
+        const int secondSpeaker = second / this->phonemeAmount;
+        const int secondPhoneme = second % this->phonemeAmount;
+
+        if( firstPhoneme == secondPhoneme ) {
+          speakerGram(firstSpeaker, secondSpeaker) += centered(first, second);
+        }
+
+        if( firstSpeaker == secondSpeaker ) {
+          phonemeGram(firstPhoneme, secondPhoneme) += centered(first, second);
+        }
+
+      }
+    }
+
+    const int truncatedSpeaker = ( this->truncateSpeaker == true ) ?
+      this->truncatedSpeakerModeDimension : this->speakerAmount;
+
+    const int truncatedPhoneme = ( this->truncatePhoneme == true ) ?
+      this->truncatedPhonemeModeDimension : this->phonemeAmount;
+
+    arma::vec S;
+
+    TensorAnalysis::compute_eigenvectors(speakerGram, this->speakerU, S);
+    TensorAnalysis::compute_eigenvectors(phonemeGram, this->phonemeU, S);
+
+    this->speakerU = this->speakerU.cols(0, truncatedSpeaker - 1);
+    this->phonemeU = this->phonemeU.cols(0, truncatedPhoneme - 1);
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  // the core tensor in mode three layout is the stored data times the
+  // Kronecker product of the singular vectors, the mean is subtracted
+  // as a rank one correction
+  Tensor compute_core_tensor() {
+
+    const int sampleAmount = this->speakerAmount * this->phonemeAmount;
+    const arma::mat weights = arma::kron(this->speakerU, this->phonemeU);
+
+    std::vector<double> coreData((size_t) this->spaceSize * weights.n_cols);
+
+    const arma::mat stored(
+      this->storage, this->spaceSize, sampleAmount, false, true);
+
+    arma::mat core(
+      coreData.data(), this->spaceSize, weights.n_cols, false, true);
+
+    core = stored * weights;
+    core -= this->runningMean * arma::sum(weights, 0);
+
+    TensorData data;
+    data.set_data(std::move(coreData))      \
+      .set_mode_dimensions(
+        this->speakerU.n_cols, this->phonemeU.n_cols, this->spaceSize
+        );
+
+    return Tensor(data);
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  std::string samplesFile;
+  std::string spillFile;
+
+  std::map< std::string, std::map<std::string, std::string> > paths;
+  std::vector<std::string> sampleFiles;
+
+  /*--------------------------------------------------------------------------*/
+
+  // storage of the shifted samples in tensor layout
+  double* storage = nullptr;
+  std::vector<double> memoryStorage;
+  MappedFile spillStorage;
+
+  /*--------------------------------------------------------------------------*/
+
+  arma::vec reference;
+  arma::vec runningMean;
+  arma::mat innerProducts;
+
+  arma::vec origin;
+  Mesh originMesh;
+  std::vector< std::vector<unsigned int> > faces;
+
+  arma::mat speakerU;
+  arma::mat phonemeU;
+
+  /*--------------------------------------------------------------------------*/
+
+  int speakerAmount;
+  int phonemeAmount;
+  int spaceSize;
+
+  int truncatedSpeakerModeDimension;
+  int truncatedPhonemeModeDimension;
+
+  bool truncateSpeaker;
+  bool truncatePhoneme;
+
+  bool samplesSet;
+  bool spill;
+
+  /*--------------------------------------------------------------------------*/
+
+};
+
+#endif
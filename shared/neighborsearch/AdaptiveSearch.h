@@ -44,32 +44,37 @@ public:
     KdTree*& kdTree,
     double& maxDist,
     double& maxAngle,
-    double& searchRadius
+    double& searchRadius,
+    int& threadAmount
     ) :
-    NormalPlaneSearch(source, target, kdTree, maxDist, maxAngle),
+    NormalPlaneSearch(
+      source, target, kdTree, maxDist, maxAngle, threadAmount),
     searchRadius(searchRadius) {
   }
 
   /*-------------------------------------------------------------------------*/
 
-  virtual void find_neighbors(
+protected:
+
+  /*-------------------------------------------------------------------------*/
+
+  virtual void find_neighbors_in_range(
+    const int& begin,
+    const int& end,
     std::vector<int>& sourceIndices,
     std::vector<int>& targetIndices
     ) const {
 
-    sourceIndices.clear();
-    targetIndices.clear();
-
-    const std::vector<arma::vec>& sourcePoints =
-      this->source.get_vertices();
+    // scratch space reused by all queries of this range
+    KdTree::Query query;
 
-    for(unsigned int sourceIndex = 0;
-        sourceIndex < sourcePoints.size(); ++sourceIndex) {
+    for(int sourceIndex = begin; sourceIndex < end; ++sourceIndex) {
 
       int bestBelowIndex = -1;
       int bestAboveIndex = -1;
 
-      if( find_candidates(sourceIndex, bestBelowIndex, bestAboveIndex) == true ) {
+      if( find_candidates(
+            sourceIndex, query, bestBelowIndex, bestAboveIndex) == true ) {
 
         sourceIndices.push_back(sourceIndex);
 
@@ -88,12 +93,9 @@ public:
 
   /*-------------------------------------------------------------------------*/
 
-protected:
-
-  /*-------------------------------------------------------------------------*/
-
   bool find_candidates(
     const int& sourceIndex,
+    KdTree::Query& query,
     int& bestBelowIndex,
     int& bestAboveIndex
     ) const {
@@ -110,12 +112,11 @@ protected:
     const arma::vec& sourceNormal =
       this->source.get_vertex_normals().at(sourceIndex);
 
-    std::vector<int> candidates =
-      this->kdTree->get_nearest_neighbors_index(
-        sourcePoint, this->searchRadius
-        );
+    this->kdTree->get_nearest_neighbors_index(
+      sourcePoint, this->searchRadius, query
+      );
 
-    for(const int& targetIndex: candidates) {
+    for(const int& targetIndex: query.indices) {
 
       if(is_valid(sourceIndex, targetIndex)) {
 
@@ -156,6 +157,7 @@ protected:
      Mesh& target;
      KdTree*& kdTree;
      double& maxDist;
+     int& threadAmount;
 
      inherited from NormalPlaneSearch:
 
@@ -26,10 +26,13 @@
 #ifndef __BASIC_SEARCH_H__
 #define __BASIC_SEARCH_H__
 
+#include <vector>
+
 #include <armadillo>
 
 #include "mesh/Mesh.h"
 #include "alignment/KdTree.h"
+#include "utility/ParallelRanges.h"
 
 #include "SearchProto.h"
 
@@ -43,16 +46,22 @@ public:
     Mesh& source,
     Mesh& target,
     KdTree*& kdTree,
-    double& maxDist
+    double& maxDist,
+    int& threadAmount
     ) :
     source(source),
     target(target),
     kdTree(kdTree),
-    maxDist(maxDist) {
+    maxDist(maxDist),
+    threadAmount(threadAmount) {
   }
 
   /*-------------------------------------------------------------------------*/
 
+  /* the source vertices are split into contiguous ranges that are processed
+   * by separate threads, the results are merged in the order of the source
+   * indices such that they do not depend on the amount of threads
+   */
   virtual void find_neighbors(
     std::vector<int>& sourceIndices,
     std::vector<int>& targetIndices
@@ -61,18 +70,63 @@ public:
     sourceIndices.clear();
     targetIndices.clear();
 
-    const std::vector<arma::vec>& sourcePoints =
+    const int sourceAmount = this->source.get_vertices().size();
+
+    const int rangeAmount =
+      ParallelRanges::range_amount(sourceAmount, this->threadAmount);
+
+    // output buffers of the different ranges
+    std::vector< std::vector<int> > sourceBuffers(rangeAmount);
+    std::vector< std::vector<int> > targetBuffers(rangeAmount);
+
+    ParallelRanges::process_ranges(sourceAmount, rangeAmount,
+      [&](const int& range, const int& begin, const int& end) {
+        find_neighbors_in_range(
+          begin, end, sourceBuffers.at(range), targetBuffers.at(range));
+      });
+
+    // merge buffers in the order of the source indices
+    for(int i = 0; i < rangeAmount; ++i) {
+
+      sourceIndices.insert(
+        sourceIndices.end(),
+        sourceBuffers.at(i).begin(), sourceBuffers.at(i).end());
+
+      targetIndices.insert(
+        targetIndices.end(),
+        targetBuffers.at(i).begin(), targetBuffers.at(i).end());
+
+    }
+
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+protected:
+
+  /*-------------------------------------------------------------------------*/
+
+  /* finds the neighbors of the source vertices with indices in
+   * [begin, end) and appends them to the provided vectors
+   */
+  virtual void find_neighbors_in_range(
+    const int& begin,
+    const int& end,
+    std::vector<int>& sourceIndices,
+    std::vector<int>& targetIndices
+    ) const {
+
+    const PointList& sourcePoints =
       this->source.get_vertices();
 
-    for(unsigned int sourceIndex = 0;
-        sourceIndex < sourcePoints.size(); ++sourceIndex) {
+    for(int sourceIndex = begin; sourceIndex < end; ++sourceIndex) {
 
       const int targetIndex =
         this->kdTree->get_nearest_neighbor_index(
           sourcePoints.at(sourceIndex)
           );
 
-      if( is_valid(sourceIndex, targetIndex) == true ) {
+      if( targetIndex != -1 && is_valid(sourceIndex, targetIndex) == true ) {
         sourceIndices.push_back(sourceIndex);
         targetIndices.push_back(targetIndex);
       }
@@ -83,10 +137,6 @@ public:
 
   /*-------------------------------------------------------------------------*/
 
-protected:
-
-  /*-------------------------------------------------------------------------*/
-
   virtual bool is_valid(
     const int& sourceIndex,
     const int& targetIndex) const {
@@ -111,6 +161,7 @@ protected:
   Mesh& target;
   KdTree*& kdTree;
   double& maxDist;
+  int& threadAmount;
 
   /*-------------------------------------------------------------------------*/
 
@@ -27,12 +27,14 @@
 #define __NEIGHBOR_SEARCH_H__
 
 #include "alignment/KdTree.h"
+#include "alignment/SpatialTree.h"
 #include "mesh/Mesh.h"
 
 #include "neighborsearch/BasicSearch.h"
 #include "neighborsearch/NormalPlaneSearch.h"
 #include "neighborsearch/AdaptiveSearch.h"
 #include "neighborsearch/FixedCorrespondences.h"
+#include "neighborsearch/SurfaceSearch.h"
 
 class NeighborSearch{
 
@@ -43,16 +45,20 @@ public:
   NeighborSearch() {
 
     this->kdTree = nullptr;
+    this->surfaceTree = nullptr;
+    this->matchSurface = false;
 
     this->searchRadius = 4;
     this->maxDist = 5;
     this->maxAngle = 60;
+    this->threadAmount = 1;
 
     this->basicSearch = new BasicSearch(
       this->source,
       this->target,
       this->kdTree,
-      this->maxDist
+      this->maxDist,
+      this->threadAmount
       );
 
     this->normalPlaneSearch = new NormalPlaneSearch(
@@ -60,7 +66,8 @@ public:
       this->target,
       this->kdTree,
       this->maxDist,
-      this->maxAngle
+      this->maxAngle,
+      this->threadAmount
       );
 
     this->adaptiveSearch = new AdaptiveSearch(
@@ -69,7 +76,8 @@ public:
       this->kdTree,
       this->maxDist,
       this->maxAngle,
-      this->searchRadius
+      this->searchRadius,
+      this->threadAmount
       );
 
     this->fixedCorrespondences = new FixedCorrespondences(
@@ -77,6 +85,16 @@ public:
       this->target
       );
 
+    this->surfaceSearch = new SurfaceSearch(
+      this->source,
+      this->target,
+      this->kdTree,
+      this->surfaceTree,
+      this->maxDist,
+      this->maxAngle,
+      this->threadAmount
+      );
+
   }
 
   /*--------------------------------------------------------------------------*/
@@ -84,10 +102,12 @@ public:
   ~NeighborSearch() {
 
     delete this->kdTree;
+    delete this->surfaceTree;
     delete this->basicSearch;
     delete this->normalPlaneSearch;
     delete this->adaptiveSearch;
     delete this->fixedCorrespondences;
+    delete this->surfaceSearch;
 
   }
 
@@ -112,20 +132,48 @@ public:
 
   /*--------------------------------------------------------------------------*/
 
+  /* sets the target mesh and updates the search structures
+   *
+   * if the amount of target vertices (and the faces for surface matching)
+   * did not change, the existing search structures are refitted in place
+   * instead of being rebuilt
+   */
   NeighborSearch& set_target(const Mesh& target, bool computeKdTree = true) {
 
-    this->target = target;
-
     if(computeKdTree == true) {
 
-      if(this->kdTree != nullptr) {
+      if(this->kdTree == nullptr ||
+         this->kdTree->refit(target.get_vertices()) == false) {
+
         delete this->kdTree;
+        this->kdTree = new KdTree(target.get_vertices());
+
       }
 
-      this->kdTree = new KdTree(target.get_vertices());
+      if(this->matchSurface == true) {
+
+        if(this->surfaceTree == nullptr) {
+          this->surfaceTree = new SpatialTree<double>();
+        }
+
+        // compared before the stored target is replaced
+        const bool sameFaces =
+          ( this->target.get_faces() == target.get_faces() );
+
+        if(sameFaces == false ||
+           this->surfaceTree->refit_vertices(target.get_vertices()) == false) {
+
+          this->surfaceTree->build_triangles(
+            target.get_vertices(), target.get_faces());
+
+        }
+
+      }
 
     }
 
+    this->target = target;
+
     return *this;
 
   }
@@ -152,6 +200,29 @@ public:
 
   /*--------------------------------------------------------------------------*/
 
+  /* enables the construction of the search structure for the target
+   * surface, has to be set before the target
+   */
+  NeighborSearch& set_surface_matching(const bool& matchSurface) {
+
+    this->matchSurface = matchSurface;
+
+    return *this;
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  NeighborSearch& set_thread_amount(const int& threadAmount) {
+
+    this->threadAmount = threadAmount;
+
+    return *this;
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
   const BasicSearch& basic() const {
 
     return *this->basicSearch;
@@ -183,6 +254,14 @@ public:
 
   /*--------------------------------------------------------------------------*/
 
+  const SurfaceSearch& surface() const {
+
+    return *this->surfaceSearch;
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
 
 private:
 
@@ -191,16 +270,20 @@ private:
   double maxDist;
   double maxAngle;
   double searchRadius;
+  int threadAmount;
+  bool matchSurface;
 
   Mesh source;
   Mesh target;
 
   KdTree* kdTree;
+  SpatialTree<double>* surfaceTree;
 
   BasicSearch* basicSearch;
   NormalPlaneSearch* normalPlaneSearch;
   AdaptiveSearch* adaptiveSearch;
   FixedCorrespondences* fixedCorrespondences;
+  SurfaceSearch* surfaceSearch;
 
   /*--------------------------------------------------------------------------*/
 
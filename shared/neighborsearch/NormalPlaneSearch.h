@@ -43,9 +43,10 @@ public:
     Mesh& target,
     KdTree*& kdTree,
     double& maxDist,
-    double& maxAngle
+    double& maxAngle,
+    int& threadAmount
     ) :
-    BasicSearch(source, target, kdTree, maxDist),
+    BasicSearch(source, target, kdTree, maxDist, threadAmount),
     maxAngle(maxAngle) {
   }
 
@@ -96,6 +97,7 @@ protected:
   Mesh& target;
   KdTree*& kdTree;
   double& maxDist;
+  int& threadAmount;
 
   */
 
@@ -0,0 +1,241 @@
+/****
+   This file is part of the multilinear-model-tools.
+   These tools are meant to derive a multilinear tongue model or
+   PCA palate model from mesh data and work with it.
+
+   Some code of the multilinear-model-tools is based on
+   Timo Bolkart's work on statistical analysis of human face shapes,
+   cf. https://sites.google.com/site/bolkartt/
+
+   Copyright (C) 2016 Alexander Hewer
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+****/
+#ifndef __SURFACE_SEARCH_H__
+#define __SURFACE_SEARCH_H__
+
+#include <vector>
+
+#include <armadillo>
+
+#include "mesh/Mesh.h"
+#include "alignment/KdTree.h"
+#include "alignment/SpatialTree.h"
+#include "utility/ParallelRanges.h"
+#include "neighborsearch/NormalPlaneSearch.h"
+
+/* search strategy that matches source vertices to the closest points on the
+ * triangles of the target surface instead of the target vertices
+ */
+class SurfaceSearch: public NormalPlaneSearch{
+
+public:
+
+  /*-------------------------------------------------------------------------*/
+
+  SurfaceSearch(
+    Mesh& source,
+    Mesh& target,
+    KdTree*& kdTree,
+    SpatialTree<double>*& surfaceTree,
+    double& maxDist,
+    double& maxAngle,
+    int& threadAmount
+    ) :
+    NormalPlaneSearch(source, target, kdTree, maxDist, maxAngle, threadAmount),
+    surfaceTree(surfaceTree) {
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+  /* version of find_neighbors() for callers that only work with target
+   * vertices: the closest corner of the matched triangle is used
+   */
+  virtual void find_neighbors(
+    std::vector<int>& sourceIndices,
+    std::vector<int>& targetIndices
+    ) const {
+
+    std::vector<arma::vec> targetPoints;
+    std::vector<arma::vec> targetNormals;
+
+    find_neighbors(sourceIndices, targetIndices, targetPoints, targetNormals);
+
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+  /* finds the closest points on the target surface
+   *
+   * targetPoints and targetNormals contain the matched surface point and
+   * the normal of the corresponding triangle, targetIndices contains the
+   * closest corner of that triangle
+   */
+  void find_neighbors(
+    std::vector<int>& sourceIndices,
+    std::vector<int>& targetIndices,
+    std::vector<arma::vec>& targetPoints,
+    std::vector<arma::vec>& targetNormals
+    ) const {
+
+    sourceIndices.clear();
+    targetIndices.clear();
+    targetPoints.clear();
+    targetNormals.clear();
+
+    const int sourceAmount = this->source.get_vertices().size();
+
+    const int rangeAmount =
+      ParallelRanges::range_amount(sourceAmount, this->threadAmount);
+
+    // output buffers of the different ranges
+    std::vector< std::vector<int> > sourceBuffers(rangeAmount);
+    std::vector< std::vector<int> > targetBuffers(rangeAmount);
+    std::vector< std::vector<arma::vec> > pointBuffers(rangeAmount);
+    std::vector< std::vector<arma::vec> > normalBuffers(rangeAmount);
+
+    ParallelRanges::process_ranges(sourceAmount, rangeAmount,
+      [&](const int& range, const int& begin, const int& end) {
+        find_surface_points_in_range(
+          begin, end,
+          sourceBuffers.at(range), targetBuffers.at(range),
+          pointBuffers.at(range), normalBuffers.at(range));
+      });
+
+    // merge buffers in the order of the source indices
+    for(int i = 0; i < rangeAmount; ++i) {
+
+      sourceIndices.insert(
+        sourceIndices.end(),
+        sourceBuffers.at(i).begin(), sourceBuffers.at(i).end());
+
+      targetIndices.insert(
+        targetIndices.end(),
+        targetBuffers.at(i).begin(), targetBuffers.at(i).end());
+
+      targetPoints.insert(
+        targetPoints.end(),
+        pointBuffers.at(i).begin(), pointBuffers.at(i).end());
+
+      targetNormals.insert(
+        targetNormals.end(),
+        normalBuffers.at(i).begin(), normalBuffers.at(i).end());
+
+    }
+
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+protected:
+
+  /*-------------------------------------------------------------------------*/
+
+  void find_surface_points_in_range(
+    const int& begin,
+    const int& end,
+    std::vector<int>& sourceIndices,
+    std::vector<int>& targetIndices,
+    std::vector<arma::vec>& targetPoints,
+    std::vector<arma::vec>& targetNormals
+    ) const {
+
+    const PointList& sourcePoints = this->source.get_vertices();
+    const PointList& sourceNormals =
+      this->source.get_vertex_normals();
+
+    const PointList& targetVertices = this->target.get_vertices();
+
+    for(int sourceIndex = begin; sourceIndex < end; ++sourceIndex) {
+
+      const arma::vec& sourcePoint = sourcePoints.at(sourceIndex);
+
+      arma::vec targetPoint(3);
+      double squaredDistance;
+
+      const int triangle = this->surfaceTree->closest_triangle(
+        sourcePoint.memptr(), targetPoint.memptr(), squaredDistance);
+
+      if( triangle == -1 ||
+          sqrt(squaredDistance) >= this->maxDist ) {
+        continue;
+      }
+
+      int corners[3];
+      this->surfaceTree->get_triangle(triangle, corners);
+
+      const arma::vec& a = targetVertices.at(corners[0]);
+      const arma::vec& b = targetVertices.at(corners[1]);
+      const arma::vec& c = targetVertices.at(corners[2]);
+
+      const arma::vec cross = arma::cross(b - a, c - a);
+
+      // degenerate triangles have no normal
+      if( arma::norm(cross) == 0 ) {
+        continue;
+      }
+
+      const arma::vec targetNormal = arma::normalise(cross);
+
+      // compute angle in degrees
+      const double angle =
+        acos(arma::norm_dot(sourceNormals.at(sourceIndex), targetNormal))
+        / M_PI * 180;
+
+      if( angle >= this->maxAngle ) {
+        continue;
+      }
+
+      // closest corner of the matched triangle
+      int targetIndex = corners[0];
+
+      for(int i = 1; i < 3; ++i) {
+        if( arma::norm(targetVertices.at(corners[i]) - targetPoint) <
+            arma::norm(targetVertices.at(targetIndex) - targetPoint) ) {
+          targetIndex = corners[i];
+        }
+      }
+
+      sourceIndices.push_back(sourceIndex);
+      targetIndices.push_back(targetIndex);
+      targetPoints.push_back(targetPoint);
+      targetNormals.push_back(targetNormal);
+
+    }
+
+  }
+
+  /*-------------------------------------------------------------------------*/
+
+  /* inherited from BasicSearch:
+
+  Mesh& source;
+  Mesh& target;
+  KdTree*& kdTree;
+  double& maxDist;
+  int& threadAmount;
+
+  inherited from NormalPlaneSearch:
+
+  double& maxAngle;
+
+  */
+
+  SpatialTree<double>*& surfaceTree;
+
+  /*-------------------------------------------------------------------------*/
+
+};
+#endif
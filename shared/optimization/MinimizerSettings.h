@@ -37,6 +37,10 @@ public:
   double projectedGradientTolerance = 0.001;
   int maxFunctionEvals = 50;
 
+  // keep the curvature information of the minimizer between consecutive
+  // minimizations, e.g., of the frames of a tracking
+  bool warmStart = false;
+
 };
 
 #endif
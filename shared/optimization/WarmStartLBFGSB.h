@@ -0,0 +1,493 @@
+/****
+   This file is part of the multilinear-model-tools.
+   These tools are meant to derive a multilinear tongue model or
+   PCA palate model from mesh data and work with it.
+
+   Some code of the multilinear-model-tools is based on
+   Timo Bolkart's work on statistical analysis of human face shapes,
+   cf. https://sites.google.com/site/bolkartt/
+
+   Copyright (C) 2016 Alexander Hewer
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+****/
+#ifndef __WARM_START_LBFGSB_H__
+#define __WARM_START_LBFGSB_H__
+
+#include <deque>
+#include <vector>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+
+#include <vnl/vnl_vector.h>
+#include <vnl/vnl_cost_function.h>
+
+/* limited memory BFGS method for box constrained problems that keeps its
+ * correction pairs between calls of minimize()
+ *
+ * meant for sequences of closely related problems, e.g., consecutive frames
+ * of a tracking, where the curvature information of the previous problem
+ * is a good initial Hessian approximation for the next one,
+ * use reset() to discard the correction pairs
+ *
+ * the settings follow vnl_lbfgsb with all variables bounded on both sides
+ */
+class WarmStartLBFGSB{
+
+public:
+
+  /*--------------------------------------------------------------------------*/
+
+  WarmStartLBFGSB(vnl_cost_function& function) : function(function) {
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  void set_lower_bound(const vnl_vector<double>& lowerBound) {
+    this->lowerBound = lowerBound;
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  void set_upper_bound(const vnl_vector<double>& upperBound) {
+    this->upperBound = upperBound;
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  void set_cost_function_convergence_factor(const double& factor) {
+    this->convergenceFactor = factor;
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  void set_projected_gradient_tolerance(const double& tolerance) {
+    this->projectedGradientTolerance = tolerance;
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  void set_max_function_evals(const int& maxFunctionEvals) {
+    this->maxFunctionEvals = maxFunctionEvals;
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  // amount of stored correction pairs
+  void set_memory(const unsigned int& memory) {
+
+    this->memory = memory;
+
+    while( this->sList.size() > this->memory ) {
+      this->sList.pop_front();
+      this->yList.pop_front();
+    }
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  // discards the curvature information of previous calls
+  void reset() {
+
+    this->sList.clear();
+    this->yList.clear();
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  // function evaluations of the last call of minimize()
+  int get_num_evaluations() const {
+    return this->evaluations;
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  /* minimizes the function starting at x, returns true if one of the
+   * convergence criteria was met before running out of function evaluations
+   */
+  bool minimize(vnl_vector<double>& x) {
+
+    const unsigned int n = x.size();
+
+    if( this->lowerBound.size() != n || this->upperBound.size() != n ) {
+      throw std::runtime_error("Bounds do not match the amount of unknowns.");
+    }
+
+    // correction pairs of a problem with another size are useless
+    if( this->sList.empty() == false && this->sList.front().size() != n ) {
+      reset();
+    }
+
+    this->evaluations = 0;
+
+    project(x);
+
+    double f;
+    vnl_vector<double> g(n, 0.);
+
+    evaluate(x, f, g);
+
+    vnl_vector<double> direction(n, 0.);
+    vnl_vector<double> xNew(n, 0.);
+    vnl_vector<double> gNew(n, 0.);
+    double fNew;
+
+    while( this->evaluations < this->maxFunctionEvals ) {
+
+      if( projected_gradient_norm(x, g) <= this->projectedGradientTolerance ) {
+        return true;
+      }
+
+      if( compute_direction(x, g, direction) == false ) {
+        return true;
+      }
+
+      if( line_search(x, f, g, direction, xNew, fNew, gNew) == false ) {
+        // no sufficient decrease along the direction: drop the curvature
+        // information once and retry along the projected gradient
+        if( this->sList.empty() == true ||
+            this->evaluations >= this->maxFunctionEvals ) {
+          return false;
+        }
+
+        reset();
+        continue;
+      }
+
+      update_pairs(x, g, xNew, gNew);
+
+      const double reduction = f - fNew;
+      const double scale =
+        std::max(std::max(std::fabs(f), std::fabs(fNew)), 1.);
+
+      x = xNew;
+      f = fNew;
+      g = gNew;
+
+      if( reduction <= this->convergenceFactor *
+          std::numeric_limits<double>::epsilon() * scale ) {
+        return true;
+      }
+
+    }
+
+    return false;
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+private:
+
+  /*--------------------------------------------------------------------------*/
+
+  void evaluate(
+    const vnl_vector<double>& x, double& f, vnl_vector<double>& g) {
+
+    this->function.compute(x, &f, &g);
+    ++this->evaluations;
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  void project(vnl_vector<double>& x) const {
+
+    for(unsigned int i = 0; i < x.size(); ++i) {
+      x[i] = std::min(std::max(x[i], this->lowerBound[i]), this->upperBound[i]);
+    }
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  // variables at a bound whose gradient points outside of the box are fixed
+  bool is_free(
+    const vnl_vector<double>& x, const vnl_vector<double>& g,
+    const unsigned int& i) const {
+
+    return !( ( x[i] <= this->lowerBound[i] && g[i] > 0 ) ||
+              ( x[i] >= this->upperBound[i] && g[i] < 0 ) );
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  // maximum norm of P(x - g) - x, cf. vnl_lbfgsb
+  double projected_gradient_norm(
+    const vnl_vector<double>& x, const vnl_vector<double>& g) const {
+
+    double norm = 0;
+
+    for(unsigned int i = 0; i < x.size(); ++i) {
+
+      const double projected = std::min(
+        std::max(x[i] - g[i], this->lowerBound[i]), this->upperBound[i]);
+
+      norm = std::max(norm, std::fabs(projected - x[i]));
+
+    }
+
+    return norm;
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  /* two-loop recursion on the free variables, returns false if no variable
+   * can be moved
+   *
+   * the correction pairs are restricted to the free variables, so they
+   * approximate the reduced Hessian instead of the full one
+   */
+  bool compute_direction(
+    const vnl_vector<double>& x, const vnl_vector<double>& g,
+    vnl_vector<double>& direction) const {
+
+    const unsigned int n = x.size();
+    const unsigned int pairAmount = this->sList.size();
+
+    std::vector<bool> isFree(n);
+    bool anyFree = false;
+
+    for(unsigned int i = 0; i < n; ++i) {
+      isFree[i] = is_free(x, g, i) && ( g[i] != 0 );
+      direction[i] = ( isFree[i] == true )? g[i]: 0.;
+      anyFree = anyFree || isFree[i];
+    }
+
+    if( anyFree == false ) {
+      return false;
+    }
+
+    // inverse curvatures of the restricted pairs, 0 marks unusable pairs
+    std::vector<double> rho(pairAmount, 0.);
+    std::vector<double> alpha(pairAmount, 0.);
+
+    double gamma = 1;
+
+    for(unsigned int k = 0; k < pairAmount; ++k) {
+
+      const double curvature = dot(this->sList[k], this->yList[k], isFree);
+      const double yy = dot(this->yList[k], this->yList[k], isFree);
+
+      if( curvature > std::numeric_limits<double>::epsilon() * yy ) {
+        rho[k] = 1. / curvature;
+        // scaling of the initial Hessian approximation by the latest pair
+        gamma = curvature / yy;
+      }
+
+    }
+
+    for(int k = pairAmount - 1; k >= 0; --k) {
+
+      if( rho[k] == 0 ) {
+        continue;
+      }
+
+      alpha[k] = rho[k] * dot(this->sList[k], direction, isFree);
+      add_scaled(-alpha[k], this->yList[k], direction, isFree);
+
+    }
+
+    for(unsigned int i = 0; i < n; ++i) {
+      direction[i] *= gamma;
+    }
+
+    for(unsigned int k = 0; k < pairAmount; ++k) {
+
+      if( rho[k] == 0 ) {
+        continue;
+      }
+
+      const double beta = rho[k] * dot(this->yList[k], direction, isFree);
+      add_scaled(alpha[k] - beta, this->sList[k], direction, isFree);
+
+    }
+
+    for(unsigned int i = 0; i < n; ++i) {
+      direction[i] = -direction[i];
+    }
+
+    return true;
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  // backtracking along the projected path with sufficient decrease
+  bool line_search(
+    const vnl_vector<double>& x, const double& f, const vnl_vector<double>& g,
+    const vnl_vector<double>& direction,
+    vnl_vector<double>& xNew, double& fNew, vnl_vector<double>& gNew) {
+
+    const unsigned int n = x.size();
+
+    double step = 1;
+
+    // without curvature information the direction is the gradient
+    if( this->sList.empty() == true ) {
+
+      double norm = 0;
+
+      for(unsigned int i = 0; i < n; ++i) {
+        norm = std::max(norm, std::fabs(direction[i]));
+      }
+
+      step = std::min(1., 1. / norm);
+
+    }
+
+    while( this->evaluations < this->maxFunctionEvals ) {
+
+      for(unsigned int i = 0; i < n; ++i) {
+        xNew[i] = x[i] + step * direction[i];
+      }
+
+      project(xNew);
+
+      double slope = 0;
+
+      for(unsigned int i = 0; i < n; ++i) {
+        slope += g[i] * ( xNew[i] - x[i] );
+      }
+
+      // the step vanished or points uphill
+      if( slope >= 0 ) {
+        return false;
+      }
+
+      evaluate(xNew, fNew, gNew);
+
+      if( fNew <= f + sufficientDecrease * slope ) {
+        return true;
+      }
+
+      step *= 0.5;
+
+    }
+
+    return false;
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  // stores the correction pair if it keeps the approximation positive definite
+  void update_pairs(
+    const vnl_vector<double>& x, const vnl_vector<double>& g,
+    const vnl_vector<double>& xNew, const vnl_vector<double>& gNew) {
+
+    vnl_vector<double> s(x.size(), 0.);
+    vnl_vector<double> y(x.size(), 0.);
+
+    for(unsigned int i = 0; i < x.size(); ++i) {
+      s[i] = xNew[i] - x[i];
+      y[i] = gNew[i] - g[i];
+    }
+
+    if( dot(s, y) <=
+        std::numeric_limits<double>::epsilon() * dot(y, y) ) {
+      return;
+    }
+
+    this->sList.push_back(s);
+    this->yList.push_back(y);
+
+    if( this->sList.size() > this->memory ) {
+      this->sList.pop_front();
+      this->yList.pop_front();
+    }
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  static double dot(const vnl_vector<double>& a, const vnl_vector<double>& b) {
+
+    double result = 0;
+
+    for(unsigned int i = 0; i < a.size(); ++i) {
+      result += a[i] * b[i];
+    }
+
+    return result;
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  // dot product restricted to the selected entries
+  static double dot(
+    const vnl_vector<double>& a, const vnl_vector<double>& b,
+    const std::vector<bool>& selection) {
+
+    double result = 0;
+
+    for(unsigned int i = 0; i < a.size(); ++i) {
+      if( selection[i] == true ) {
+        result += a[i] * b[i];
+      }
+    }
+
+    return result;
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  // b += factor * a on the selected entries
+  static void add_scaled(
+    const double& factor, const vnl_vector<double>& a, vnl_vector<double>& b,
+    const std::vector<bool>& selection) {
+
+    for(unsigned int i = 0; i < a.size(); ++i) {
+      if( selection[i] == true ) {
+        b[i] += factor * a[i];
+      }
+    }
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  vnl_cost_function& function;
+
+  vnl_vector<double> lowerBound;
+  vnl_vector<double> upperBound;
+
+  double convergenceFactor = 1e7;
+  double projectedGradientTolerance = 1e-5;
+  int maxFunctionEvals = 100;
+
+  // correction pairs, the latest pair is stored at the end
+  unsigned int memory = 5;
+  std::deque< vnl_vector<double> > sList;
+  std::deque< vnl_vector<double> > yList;
+
+  int evaluations = 0;
+
+  // constant of the sufficient decrease condition
+  static constexpr double sufficientDecrease = 1e-4;
+
+  /*--------------------------------------------------------------------------*/
+
+};
+
+#endif
@@ -31,7 +31,7 @@
 #include <armadillo>
 #include <vnl/vnl_vector.h>
 
-#include "model/Model.h"
+#include "model/ModelJacobian.h"
 #include "optimization/fitmodel/Energy.h"
 #include "optimization/fitmodel/EnergyTerm.h"
 
@@ -53,26 +53,26 @@ namespace fitModel{
       double& energy,
       vnl_vector<double>& gradient) const {
 
+      const ModelJacobian& jacobian =
+        this->energy.derived_data().dataJacobian;
+
+      // rows of the derivatives follow the order of the correspondences
       const arma::vec difference =
         this->energy.derived_data().linearizedSource -
         this->energy.derived_data().linearizedTarget;
 
       // get weight for data term
-      const double& factor =
-        this->energy.derived_data().weights.at("dataTerm");
+      const double& factor = this->energy.derived_data().weights.dataTerm;
 
       // add energy
       energy += factor * arma::dot(difference, difference);
 
       // compute gradient
-      arma::mat speakerDerivative = get_speaker_derivative();
-      arma::mat phonemeDerivative = get_phoneme_derivative();
-
       const arma::vec speakerGradient =
-        2 * factor * speakerDerivative * difference;
+        2 * factor * jacobian.speaker().t() * difference;
 
       const arma::vec phonemeGradient =
-        2 * factor * phonemeDerivative * difference;
+        2 * factor * jacobian.phoneme().t() * difference;
 
       for(unsigned int i = 0; i < speakerGradient.n_rows; ++i) {
         gradient[i] += speakerGradient(i);
@@ -92,20 +92,6 @@ namespace fitModel{
 
     /*--------------------------------------------------------------------------*/
 
-    arma::mat get_speaker_derivative() const {
-      return this->energy.data().model.derivative().speaker(
-        this->energy.data().phonemeWeights).t();
-    }
-
-    /*--------------------------------------------------------------------------*/
-
-    arma::mat get_phoneme_derivative() const {
-      return this->energy.data().model.derivative().phoneme(
-        this->energy.data().speakerWeights).t();
-    }
-
-    /*--------------------------------------------------------------------------*/
-
     Energy& energy;
 
     /*--------------------------------------------------------------------------*/
@@ -46,6 +46,7 @@ namespace fitModel{
       EnergySettings& energySettings
       ) :
       energyData(energyData),
+      energyDerivedData(energyData.model),
       energySettings(energySettings) {
 
       this->energyNeighbor =
@@ -105,6 +105,11 @@ namespace fitModel{
 
     std::vector<Landmark> landmarks;
 
+    /* model vertices the source mesh consists of,
+     * the source mesh contains all model vertices if no ids are set
+     */
+    std::vector<int> sourceIds;
+
     /*--------------------------------------------------------------------------*/
 
   };
@@ -27,11 +27,16 @@
 #define __FIT_MODEL_ENERGY_DERIVED_DATA_H__
 
 #include <vector>
-#include <map>
 
 #include <armadillo>
 
 #include "mesh/Mesh.h"
+#include "mesh/NormalEstimation.h"
+#include "model/Model.h"
+#include "model/ModelJacobian.h"
+#include "model/ModelRowView.h"
+
+#include "optimization/fitmodel/EnergyWeights.h"
 
 namespace fitModel{
 
@@ -45,21 +50,46 @@ namespace fitModel{
 
     /*--------------------------------------------------------------------------*/
 
+    EnergyDerivedData(const Model& model) :
+      sourceView(model.data(), model.space()),
+      dataJacobian(model.derivative().jacobian()),
+      landmarkJacobian(model.derivative().jacobian()) {
+    }
+
+    /*--------------------------------------------------------------------------*/
+
     /* source mesh that depends on the chosen model parameters
      * selected in EnergyData
      */
     Mesh source;
 
+    /* normal estimation for the source mesh, keeps the corners of the
+     * source mesh between updates
+     */
+    NormalEstimation normalEstimation;
+
+    /* model restricted to the vertices of the source mesh,
+     * only used if source ids are set in EnergyData
+     */
+    ModelRowView sourceView;
+
     /* indices that represent the neighbor correspondence between
      * source and target
      */
     std::vector<int> sourceIndices;
     std::vector<int> targetIndices;
 
+    /* matched points on the target surface and the normals of the
+     * corresponding triangles, only set if the surface search strategy is
+     * used, in this case they replace the target vertices
+     */
+    std::vector<arma::vec> targetPoints;
+    std::vector<arma::vec> targetNormals;
+
     /* linearized vertex data of source and target mesh
      *
-     * only vertices belonging to the neighbor correspondences are set,
-     * all other values are 0
+     * only vertices belonging to the neighbor correspondences are stored,
+     * entries 3 * i to 3 * i + 2 belong to correspondence i
      *
      * ATTENTION: linearizedTarget may contain points that were projected
      * onto the normal plane of the corresponding target vertex
@@ -67,15 +97,24 @@ namespace fitModel{
     arma::vec linearizedSource;
     arma::vec linearizedTarget;
 
-    /* linearized data for the landmark correspondences */
+    /* linearized data for the landmark correspondences,
+     * stored in the order of the landmarks
+     */
     arma::vec linearizedLandmarkSource;
     arma::vec linearizedLandmarkTarget;
 
+    /* derivatives of the model restricted to the source vertices of the
+     * neighbor and landmark correspondences, the row views of the
+     * derivatives are used for reconstructing only these vertices
+     */
+    ModelJacobian dataJacobian;
+    ModelJacobian landmarkJacobian;
+
     /* indicators for landmark presence */
     std::vector<bool> isLandmark;
 
     /* weights derived from settings and current data */
-    std::map<std::string, double> weights;
+    EnergyWeights weights;
 
     /*--------------------------------------------------------------------------*/
 
@@ -26,6 +26,8 @@
 #ifndef __ENERGY_DERIVED_DATA_UPDATE_H__
 #define __ENERGY_DERIVED_DATA_UPDATE_H__
 
+#include <vector>
+
 #include "mesh/NormalEstimation.h"
 
 #include "optimization/fitmodel/EnergyData.h"
@@ -56,26 +58,76 @@ namespace fitModel{
     /* updates normals of the source mesh that depend on the current vertices */
     void source_normals() {
 
-      NormalEstimation estimator(this->energyDerivedData.source);
-      this->energyDerivedData.source.set_vertex_normals(estimator.compute());
+      Mesh& source = this->energyDerivedData.source;
+      NormalEstimation& estimation = this->energyDerivedData.normalEstimation;
+
+      estimation.set_thread_amount(this->energySettings.threadAmount);
+      estimation.set_mesh(source);
+      estimation.compute(source.get_vertex_normals());
 
     }
 
     /*--------------------------------------------------------------------------*/
 
-    /* updates the vertices of the source mesh
-     * that depend on the chosen model parameters
+    /* updates the source mesh for the chosen model parameters
+     *
+     * if source ids are set in EnergyData, only the corresponding model
+     * vertices are reconstructed, otherwise the full mesh is reconstructed
+     * in place and keeps the faces of the previous update
      */
-    void for_weights() {
+    void source_mesh() {
+
+      const arma::vec& speakerWeights = this->energyData.speakerWeights;
+      const arma::vec& phonemeWeights = this->energyData.phonemeWeights;
+
+      if( this->energyData.sourceIds.empty() == true ) {
 
-      this->energyDerivedData.source =
         energyData.model.reconstruct_mesh().for_weights(
-          energyData.speakerWeights, energyData.phonemeWeights
+          speakerWeights, phonemeWeights, this->energyDerivedData.source
           );
 
-      linearize_source();
+        return;
 
-      linearize_landmark_source();
+      }
+
+      ModelRowView& sourceView = this->energyDerivedData.sourceView;
+
+      sourceView.set_vertex_indices(this->energyData.sourceIds);
+
+      arma::vec values;
+
+      sourceView.for_weights(speakerWeights, phonemeWeights, values);
+
+      // the values already have the layout of the vertex storage
+      this->energyDerivedData.source = Mesh();
+      this->energyDerivedData.source.get_vertices().assign(values);
+
+    }
+
+    /*--------------------------------------------------------------------------*/
+
+    /* updates the linearized source vertices of the neighbor and landmark
+     * correspondences that depend on the chosen model parameters
+     *
+     * only these vertices are reconstructed, the source mesh itself is
+     * updated by source_mesh()
+     */
+    void for_weights() {
+
+      const arma::vec& speakerWeights = this->energyData.speakerWeights;
+      const arma::vec& phonemeWeights = this->energyData.phonemeWeights;
+
+      this->energyDerivedData.dataJacobian.rows().for_weights(
+        speakerWeights, phonemeWeights,
+        this->energyDerivedData.linearizedSource
+        );
+
+      this->energyDerivedData.landmarkJacobian.rows().for_weights(
+        speakerWeights, phonemeWeights,
+        this->energyDerivedData.linearizedLandmarkSource
+        );
+
+      update_jacobians();
 
     }
 
@@ -86,10 +138,15 @@ namespace fitModel{
 
       linearize_source_and_target();
 
+      this->energyDerivedData.dataJacobian.set_vertex_indices(
+        to_model_indices(this->energyDerivedData.sourceIndices));
+
+      update_jacobians();
+
       // update data term weight
-      const double weight = this->energySettings.weights.at("dataTerm");
+      const double weight = this->energySettings.weights.dataTerm;
 
-      this->energyDerivedData.weights["dataTerm"] = weight /
+      this->energyDerivedData.weights.dataTerm = weight /
         ( ( this->energyDerivedData.sourceIndices.size() == 0)?
           1. : this->energyDerivedData.sourceIndices.size() );
 
@@ -105,11 +162,21 @@ namespace fitModel{
       linearize_landmark_source();
       linearize_landmark_target();
 
+      std::vector<int> landmarkIndices;
+
+      for(const Landmark& landmark: this->energyData.landmarks) {
+        landmarkIndices.push_back(landmark.sourceIndex);
+      }
+
+      this->energyDerivedData.landmarkJacobian.set_vertex_indices(
+        to_model_indices(landmarkIndices));
+
+      update_jacobians();
+
       // update landmark term weight
-      const double weight =
-        this->energySettings.weights.at("landmarkTerm");
+      const double weight = this->energySettings.weights.landmarkTerm;
 
-      this->energyDerivedData.weights["landmarkTerm"] = weight /
+      this->energyDerivedData.weights.landmarkTerm = weight /
         ( ( this->energyData.landmarks.size() == 0)?
           1. : this->energyData.landmarks.size() );
 
@@ -121,43 +188,45 @@ namespace fitModel{
 
     /*--------------------------------------------------------------------------*/
 
-    /* linearize vertices of the source mesh that are present in the
-     * neighbor correspondences, set all other values to 0
-     */
-    void linearize_source() {
-
-      // setup helper variables for accessing the necessary data
-      const std::vector<arma::vec>& sourceVertices =
-        this->energyDerivedData.source.get_vertices();
+    /* recomputes the cached derivatives if the weights changed */
+    void update_jacobians() {
 
-      const std::vector<int>& sourceIndices =
-        this->energyDerivedData.sourceIndices;
+      this->energyDerivedData.dataJacobian.update(
+        this->energyData.speakerWeights, this->energyData.phonemeWeights);
 
-      arma::vec& linearizedSource = this->energyDerivedData.linearizedSource;
-
-      // setup end
+      this->energyDerivedData.landmarkJacobian.update(
+        this->energyData.speakerWeights, this->energyData.phonemeWeights);
 
-      linearizedSource = arma::vec(3 * sourceVertices.size(), arma::fill::zeros);
+    }
 
-      for(unsigned int i = 0; i < sourceIndices.size(); ++i) {
+    /*--------------------------------------------------------------------------*/
 
-        const int index = sourceIndices.at(i);
-        const arma::vec& point = sourceVertices.at(index);
+    /* maps indices of the source mesh to the corresponding model vertices */
+    std::vector<int> to_model_indices(
+      const std::vector<int>& sourceIndices) const {
 
-        for(int j = 0; j < 3; ++j) {
+      const std::vector<int>& sourceIds = this->energyData.sourceIds;
 
-          linearizedSource(3 * index + j) = point(j);
+      if( sourceIds.empty() == true ) {
+        return sourceIndices;
+      }
 
-        }
+      std::vector<int> modelIndices;
+      modelIndices.reserve(sourceIndices.size());
 
+      for(const int& index: sourceIndices) {
+        modelIndices.push_back(sourceIds.at(index));
       }
 
+      return modelIndices;
+
     }
 
     /*--------------------------------------------------------------------------*/
 
     /* linearize corresponding vertices of the source and target meshes that are
-     * present in the neighbor correspondences, set all other values to 0
+     * present in the neighbor correspondences in the order of the
+     * correspondences
      *
      * if required compute the projection onto the normal plane of the
      * corresponding target vertex
@@ -165,10 +234,10 @@ namespace fitModel{
     void linearize_source_and_target() {
 
       // setup helper variables for accessing the necessary data
-      const std::vector<arma::vec>& sourceVertices =
+      const PointList& sourceVertices =
         this->energyDerivedData.source.get_vertices();
 
-      const std::vector<arma::vec>& targetVertices =
+      const PointList& targetVertices =
         this->energyData.target.get_vertices();
 
       const std::vector<int>& sourceIndices =
@@ -177,16 +246,23 @@ namespace fitModel{
       const std::vector<int>& targetIndices =
         this->energyDerivedData.targetIndices;
 
+      // matched points on the target surface, replace the target vertices
+      // if present
+      const std::vector<arma::vec>& targetPoints =
+        this->energyDerivedData.targetPoints;
+
+      const std::vector<arma::vec>& targetNormals =
+        this->energyDerivedData.targetNormals;
+
+      const bool useSurface = ( targetPoints.empty() == false );
+
       arma::vec& linearizedSource = this->energyDerivedData.linearizedSource;
       arma::vec& linearizedTarget = this->energyDerivedData.linearizedTarget;
 
       // setup end
 
-      linearizedSource =
-        arma::vec(3 * sourceVertices.size(), arma::fill::zeros);
-
-      linearizedTarget =
-        arma::vec(3 * sourceVertices.size(), arma::fill::zeros);
+      linearizedSource.set_size(3 * sourceIndices.size());
+      linearizedTarget.set_size(3 * sourceIndices.size());
 
       for(unsigned int i = 0; i < sourceIndices.size(); ++i) {
 
@@ -196,16 +272,19 @@ namespace fitModel{
         const arma::vec& sourcePoint = sourceVertices.at(sourceIndex);
 
         // target point is no const reference, it might change
-        arma::vec targetPoint = targetVertices.at(targetIndex);
+        arma::vec targetPoint = ( useSurface == true )?
+          targetPoints.at(i) : arma::vec(targetVertices.at(targetIndex));
 
         // check if we are using the projection onto the normal plane
         if(
           this->energySettings.useProjection &&
-          this->energyData.target.has_normals()
+          ( useSurface || this->energyData.target.has_normals() )
           ) {
 
-          const arma::vec& targetNormal =
-            this->energyData.target.get_vertex_normals().at(targetIndex);
+          const arma::vec& targetNormal = ( useSurface == true )?
+            targetNormals.at(i) :
+            arma::vec(
+              this->energyData.target.get_vertex_normals().at(targetIndex));
 
           // compute the projection point and use it as new target point
           targetPoint = sourcePoint + arma::dot(
@@ -215,9 +294,9 @@ namespace fitModel{
 
         for(int j = 0; j < 3; ++j) {
 
-          linearizedSource(3 * sourceIndex + j) = sourcePoint(j);
+          linearizedSource(3 * i + j) = sourcePoint(j);
 
-          linearizedTarget(3 * sourceIndex + j) = targetPoint(j);
+          linearizedTarget(3 * i + j) = targetPoint(j);
 
         } // end for j
 
@@ -248,7 +327,7 @@ namespace fitModel{
     void linearize_landmark_source() {
 
       // setup helper variables for accessing the necessary data
-      const std::vector<arma::vec>& sourceVertices =
+      const PointList& sourceVertices =
         this->energyDerivedData.source.get_vertices();
 
       const std::vector<Landmark>& landmarks =
@@ -259,7 +338,7 @@ namespace fitModel{
 
       // setup end
 
-      linearizedLandmarkSource = arma::vec(3 * sourceVertices.size(), arma::fill::zeros);
+      linearizedLandmarkSource.set_size(3 * landmarks.size());
 
       for(unsigned int i = 0; i < landmarks.size(); ++i) {
 
@@ -268,7 +347,7 @@ namespace fitModel{
 
         for(int j = 0; j < 3; ++j) {
 
-          linearizedLandmarkSource(3 * index + j) = point(j);
+          linearizedLandmarkSource(3 * i + j) = point(j);
 
         } // end for j
 
@@ -281,9 +360,6 @@ namespace fitModel{
     void linearize_landmark_target() {
 
       // setup helper variables for accessing the necessary data
-      const std::vector<arma::vec>& sourceVertices =
-        this->energyDerivedData.source.get_vertices();
-
       const std::vector<Landmark>& landmarks =
         this->energyData.landmarks;
 
@@ -292,16 +368,15 @@ namespace fitModel{
 
       // setup end
 
-      linearizedLandmarkTarget = arma::vec(3 * sourceVertices.size(), arma::fill::zeros);
+      linearizedLandmarkTarget.set_size(3 * landmarks.size());
 
       for(unsigned int i = 0; i < landmarks.size(); ++i) {
 
-        const int index = landmarks.at(i).sourceIndex;
         const arma::vec& point = landmarks.at(i).targetPosition;
 
         for(int j = 0; j < 3; ++j) {
 
-          linearizedLandmarkTarget(3 * index + j) = point(j);
+          linearizedLandmarkTarget(3 * i + j) = point(j);
 
         } // end for j
 
@@ -96,7 +96,8 @@ namespace fitModel{
 
     Energy& energy;
 
-    std::vector<EnergyTerm*> energyTerms;
+    // owned by the minimizer, terms may change between minimizations
+    const std::vector<EnergyTerm*>& energyTerms;
 
     /*--------------------------------------------------------------------------*/
 
@@ -26,6 +26,8 @@
 #ifndef __FIT_MODEL_ENERGY_MINIMIZER_H__
 #define __FIT_MODEL_ENERGY_MINIMIZER_H__
 
+#include <stdexcept>
+
 #include <vnl/vnl_vector.h>
 #include <vnl/vnl_cost_function.h>
 #include <vnl/algo/vnl_lbfgsb.h>
@@ -37,6 +39,7 @@
 #include "optimization/fitmodel/SmoothnessTerm.h"
 #include "optimization/fitmodel/ITKWrapper.h"
 #include "optimization/MinimizerSettings.h"
+#include "optimization/WarmStartLBFGSB.h"
 
 namespace fitModel{
 
@@ -55,41 +58,12 @@ namespace fitModel{
 
       const Model& model = this->energy.data().model;
 
-      const int dimensionSpeaker = model.data().get_speaker_mode_dimension();
-      const int dimensionPhoneme = model.data().get_phoneme_mode_dimension();
-
-      const int numWeights = dimensionSpeaker + dimensionPhoneme;
-
-      this->weightAmount = numWeights;
-
-      arma::vec lowerSpeaker;
-      arma::vec lowerPhoneme;
-      arma::vec upperSpeaker;
-      arma::vec upperPhoneme;
-
-      construct_box_boundary_weights(
-        lowerSpeaker, lowerPhoneme, upperSpeaker, upperPhoneme);
-
-      // check for PCA model
-      if( dimensionSpeaker == 1 || dimensionPhoneme == 1) {
-        adapt_box_to_pca(
-          lowerSpeaker, lowerPhoneme, upperSpeaker, upperPhoneme);
-      }
-
-      // create needed energy terms
-      this->energyTerms.push_back(new DataTerm(energy));
-
-      if(this->energy.data().landmarks.size() > 0) {
-        this->energyTerms.push_back(new LandmarkTerm(energy));
-      }
-
-      if(this->energy.settings().weights.at("speakerSmoothnessTerm") > 0 ||
-         this->energy.settings().weights.at("phonemeSmoothnessTerm") > 0) {
-        this->energyTerms.push_back(new SmoothnessTerm(energy));
-      }
+      this->weightAmount =
+        model.data().get_speaker_mode_dimension() +
+        model.data().get_phoneme_mode_dimension();
 
-      setup_minimizer(
-        lowerSpeaker, lowerPhoneme, upperSpeaker, upperPhoneme);
+      setup_energy_terms();
+      setup_minimizer();
 
     }
 
@@ -98,6 +72,7 @@ namespace fitModel{
     ~EnergyMinimizer() {
       delete this->energyFunction;
       delete this->minimizer;
+      delete this->warmStartMinimizer;
       for(EnergyTerm* energyTerm : this->energyTerms) {
         delete energyTerm;
       }
@@ -105,14 +80,30 @@ namespace fitModel{
 
     /*--------------------------------------------------------------------------*/
 
+    /* applies changed settings of the energy and the minimizer, e.g., term
+     * weights or the prior size, without discarding the curvature
+     * information of a warm started minimizer
+     */
+    void update_settings() {
+
+      setup_energy_terms();
+      apply_settings();
+
+    }
+
+    /*--------------------------------------------------------------------------*/
+
     void minimize() {
 
-      // initialize data structures for current weights
-      this->energy.update().for_weights();
+      // initialize source mesh for current weights
+      this->energy.update().source_mesh();
 
       // initialize data structures for current landmarks
       this->energy.update().for_landmarks();
 
+      // initialize data structures for current weights
+      this->energy.update().for_weights();
+
       // compute neighbors if fixed correspondences are used
       if(this->energy.neighbors().are_fixed() == true) {
         this->energy.neighbors().compute();
@@ -161,7 +152,12 @@ namespace fitModel{
         );
 
       // find minimizer
-      this->minimizer->minimize(x);
+      if( this->warmStartMinimizer != nullptr ) {
+        this->warmStartMinimizer->minimize(x);
+      }
+      else {
+        this->minimizer->minimize(x);
+      }
 
       // set new weights
       ITKWrapper::vnl_vector_to_weights(
@@ -173,6 +169,9 @@ namespace fitModel{
       // update data structures depending on weights
       this->energy.update().for_weights();
 
+      // reconstruct the whole source mesh once per iteration
+      this->energy.update().source_mesh();
+
     }
 
     /*--------------------------------------------------------------------------*/
@@ -230,48 +229,125 @@ namespace fitModel{
 
     /*--------------------------------------------------------------------------*/
 
-    void setup_minimizer(
-      const arma::vec& lowerSpeaker,
-      const arma::vec& lowerPhoneme,
-      const arma::vec& upperSpeaker,
-      const arma::vec& upperPhoneme
-      ) {
+    void setup_energy_terms() {
 
-      const int dimensionSpeaker = lowerSpeaker.size();
-      const int dimensionPhoneme = lowerPhoneme.size();
+      for(EnergyTerm* energyTerm : this->energyTerms) {
+        delete energyTerm;
+      }
 
-      vnl_vector<long> boundSelection(this->weightAmount, 2);
-      vnl_vector<double> lowerBounds(this->weightAmount, 0.);
-      vnl_vector<double> upperBounds(this->weightAmount, 0.);
+      this->energyTerms.clear();
 
-      for(int i = 0; i < dimensionSpeaker; ++i) {
-        lowerBounds[i] = lowerSpeaker(i);
-        upperBounds[i] = upperSpeaker(i);
+      // create needed energy terms
+      this->energyTerms.push_back(new DataTerm(energy));
+
+      if(this->energy.data().landmarks.size() > 0) {
+        this->energyTerms.push_back(new LandmarkTerm(energy));
       }
 
-      for(int i = 0; i < dimensionPhoneme; ++i) {
-        lowerBounds[dimensionSpeaker + i] = lowerPhoneme(i);
-        upperBounds[dimensionSpeaker + i] = upperPhoneme(i);
+      if(this->energy.settings().weights.use_smoothness_term()) {
+        this->energyTerms.push_back(new SmoothnessTerm(energy));
       }
 
+    }
+
+    /*--------------------------------------------------------------------------*/
+
+    void setup_minimizer() {
+
       this->energyFunction = new EnergyFunction(energy, this->energyTerms);
-      this->minimizer = new vnl_lbfgsb(*this->energyFunction);
 
-      this->minimizer->set_cost_function_convergence_factor(
+      this->minimizer = nullptr;
+      this->warmStartMinimizer = nullptr;
+
+      if( this->settings.warmStart == true ) {
+        this->warmStartMinimizer = new WarmStartLBFGSB(*this->energyFunction);
+      }
+      else {
+        this->minimizer = new vnl_lbfgsb(*this->energyFunction);
+
+        vnl_vector<long> boundSelection(this->weightAmount, 2);
+        this->minimizer->set_bound_selection(boundSelection);
+      }
+
+      apply_settings();
+
+    }
+
+    /*--------------------------------------------------------------------------*/
+
+    void apply_settings() {
+
+      vnl_vector<double> lowerBounds(this->weightAmount, 0.);
+      vnl_vector<double> upperBounds(this->weightAmount, 0.);
+
+      compute_bounds(lowerBounds, upperBounds);
+
+      if( this->warmStartMinimizer != nullptr ) {
+        configure(*this->warmStartMinimizer, lowerBounds, upperBounds);
+      }
+      else {
+        configure(*this->minimizer, lowerBounds, upperBounds);
+      }
+
+    }
+
+    /*--------------------------------------------------------------------------*/
+
+    // both minimizers share the interface of vnl_lbfgsb
+    template<typename T>
+    void configure(
+      T& minimizer,
+      const vnl_vector<double>& lowerBounds,
+      const vnl_vector<double>& upperBounds
+      ) const {
+
+      minimizer.set_cost_function_convergence_factor(
         this->settings.convergenceFactor
         );
 
-      this->minimizer->set_projected_gradient_tolerance(
+      minimizer.set_projected_gradient_tolerance(
         this->settings.projectedGradientTolerance
         );
 
-      this->minimizer->set_max_function_evals(
+      minimizer.set_max_function_evals(
         this->settings.maxFunctionEvals
         );
 
-      this->minimizer->set_bound_selection(boundSelection);
-      this->minimizer->set_lower_bound(lowerBounds);
-      this->minimizer->set_upper_bound(upperBounds);
+      minimizer.set_lower_bound(lowerBounds);
+      minimizer.set_upper_bound(upperBounds);
+
+    }
+
+    /*--------------------------------------------------------------------------*/
+
+    void compute_bounds(
+      vnl_vector<double>& lowerBounds,
+      vnl_vector<double>& upperBounds
+      ) const {
+
+      arma::vec lowerSpeaker;
+      arma::vec lowerPhoneme;
+      arma::vec upperSpeaker;
+      arma::vec upperPhoneme;
+
+      construct_box_boundary_weights(
+        lowerSpeaker, lowerPhoneme, upperSpeaker, upperPhoneme);
+
+      // check for PCA model
+      if( lowerSpeaker.n_elem == 1 || lowerPhoneme.n_elem == 1) {
+        adapt_box_to_pca(
+          lowerSpeaker, lowerPhoneme, upperSpeaker, upperPhoneme);
+      }
+
+      if( lowerSpeaker.n_elem + lowerPhoneme.n_elem != lowerBounds.size() ) {
+        throw std::runtime_error(
+          "Model dimensions changed after creating the minimizer.");
+      }
+
+      ITKWrapper::weights_to_vnl_vector(
+        lowerSpeaker, lowerPhoneme, lowerBounds);
+      ITKWrapper::weights_to_vnl_vector(
+        upperSpeaker, upperPhoneme, upperBounds);
 
     }
 
@@ -287,6 +363,9 @@ namespace fitModel{
 
     vnl_lbfgsb* minimizer;
 
+    // only used if warm starts are enabled in the settings
+    WarmStartLBFGSB* warmStartMinimizer;
+
     int weightAmount;
 
 
@@ -49,13 +49,13 @@ namespace fitModel{
         energyDerivedData(energyDerivedData),
         energySettings(energySettings) {
 
-      // set target and construct kd-tree
-      this->neighborSearch.set_target(this->energyData.target);
       this->areFixed = false;
+      this->matchSurface = false;
 
       // configure search strategy
       this->neighborSearch.set_max_angle(this->energySettings.maxAngle);
       this->neighborSearch.set_max_distance(this->energySettings.maxDistance);
+      this->neighborSearch.set_thread_amount(this->energySettings.threadAmount);
 
       // select wanted search strategy
       switch(this->energySettings.searchStrategy) {
@@ -81,12 +81,22 @@ namespace fitModel{
         this->areFixed = true;
         break;
 
+      case EnergySettings::SearchStrategy::SURFACE:
+        this->searchStrategy = &(this->neighborSearch.surface());
+        this->needNormals = true;
+        this->matchSurface = true;
+        break;
+
       default:
         this->searchStrategy = &(this->neighborSearch.basic());
         this->needNormals = false;
         break;
       } // end switch
 
+      // set target and construct search structures
+      this->neighborSearch.set_surface_matching(this->matchSurface);
+      this->neighborSearch.set_target(this->energyData.target);
+
     }
 
     /*--------------------------------------------------------------------------*/
@@ -98,15 +108,28 @@ namespace fitModel{
 
       std::vector<int> sourceIndices;
       std::vector<int> targetIndices;
-
+      std::vector<arma::vec> targetPoints;
+      std::vector<arma::vec> targetNormals;
 
       this->energyDerivedData.sourceIndices.clear();
       this->energyDerivedData.targetIndices.clear();
-
-      this->searchStrategy->find_neighbors(
-        sourceIndices,
-        targetIndices
-        );
+      this->energyDerivedData.targetPoints.clear();
+      this->energyDerivedData.targetNormals.clear();
+
+      if( this->matchSurface == true ) {
+        this->neighborSearch.surface().find_neighbors(
+          sourceIndices,
+          targetIndices,
+          targetPoints,
+          targetNormals
+          );
+      }
+      else {
+        this->searchStrategy->find_neighbors(
+          sourceIndices,
+          targetIndices
+          );
+      }
 
       // remove indices that belong to landmarks
       for(size_t i = 0; i < sourceIndices.size(); ++i) {
@@ -118,6 +141,11 @@ namespace fitModel{
         this->energyDerivedData.sourceIndices.push_back(sourceIndices.at(i));
         this->energyDerivedData.targetIndices.push_back(targetIndices.at(i));
 
+        if( this->matchSurface == true ) {
+          this->energyDerivedData.targetPoints.push_back(targetPoints.at(i));
+          this->energyDerivedData.targetNormals.push_back(targetNormals.at(i));
+        }
+
       }
 
     }
@@ -155,6 +183,7 @@ namespace fitModel{
 
     bool areFixed;
     bool needNormals;
+    bool matchSurface;
     EnergyData& energyData;
     EnergyDerivedData& energyDerivedData;
     EnergySettings& energySettings;
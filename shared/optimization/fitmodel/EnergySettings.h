@@ -26,7 +26,7 @@
 #ifndef __FIT_MODEL_ENERGY_SETTINGS_H__
 #define __FIT_MODEL_ENERGY_SETTINGS_H__
 
-#include <map>
+#include "optimization/fitmodel/EnergyWeights.h"
 
 namespace fitModel{
 
@@ -34,19 +34,12 @@ namespace fitModel{
 
   public:
 
-    EnergySettings() {
-      this->weights["dataTerm"] = 1;
-      this->weights["landmarkTerm"] = 0;
-      this->weights["speakerSmoothnessTerm"] = 1;
-      this->weights["phonemeSmoothnessTerm"] = 1;
-    }
-
     // should source points be projected onto the normal plane of the
     // target point?
     bool useProjection = true;
 
     // weights for the different energy terms
-    std::map<std::string, double> weights;
+    EnergyWeights weights;
 
     // upper bound for distance during nearest neighbor search
     double maxDistance = 5;
@@ -61,11 +54,15 @@ namespace fitModel{
       BASIC,
       NORMAL_PLANE,
       ADAPTIVE,
-      FIXED
+      FIXED,
+      SURFACE
     };
 
     // search strategy for nearest neighbor search
     SearchStrategy searchStrategy = SearchStrategy::NORMAL_PLANE;
+
+    // amount of threads used during nearest neighbor search
+    int threadAmount = 1;
   };
 
 }
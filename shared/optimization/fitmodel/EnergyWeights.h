@@ -0,0 +1,60 @@
+/****
+   This file is part of the multilinear-model-tools.
+   These tools are meant to derive a multilinear tongue model or
+   PCA palate model from mesh data and work with it.
+
+   Some code of the multilinear-model-tools is based on
+   Timo Bolkart's work on statistical analysis of human face shapes,
+   cf. https://sites.google.com/site/bolkartt/
+
+   Copyright (C) 2016 Alexander Hewer
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+****/
+#ifndef __FIT_MODEL_ENERGY_WEIGHTS_H__
+#define __FIT_MODEL_ENERGY_WEIGHTS_H__
+
+namespace fitModel{
+
+  /* weights of the energy terms, read directly by the terms during every
+   * energy evaluation
+   */
+  class EnergyWeights{
+
+  public:
+
+    /*--------------------------------------------------------------------------*/
+
+    double dataTerm = 1;
+    double landmarkTerm = 0;
+    double speakerSmoothnessTerm = 1;
+    double phonemeSmoothnessTerm = 1;
+
+    /*--------------------------------------------------------------------------*/
+
+    bool use_smoothness_term() const {
+
+      return this->speakerSmoothnessTerm > 0 ||
+        this->phonemeSmoothnessTerm > 0;
+
+    }
+
+    /*--------------------------------------------------------------------------*/
+
+  };
+
+}
+
+#endif
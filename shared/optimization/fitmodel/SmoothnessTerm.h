@@ -66,10 +66,10 @@ namespace fitModel{
 
       // get energy term weights
       const double& speakerWeight =
-        this->energy.settings().weights.at("speakerSmoothnessTerm");
+        this->energy.settings().weights.speakerSmoothnessTerm;
 
       const double& phonemeWeight =
-        this->energy.settings().weights.at("phonemeSmoothnessTerm");
+        this->energy.settings().weights.phonemeSmoothnessTerm;
 
       // add energy
       energy +=
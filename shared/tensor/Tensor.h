@@ -78,7 +78,7 @@ public:
 
     this->tensorAccess = new TensorAccess(this->tensorData);
     this->tensorModes = new TensorModes(this->tensorData, *this->tensorAccess);
-    this->tensorOperations = new TensorOperations(*this->tensorModes);
+    this->tensorOperations = new TensorOperations(this->tensorData);
     this->tensorTruncator =
       new TensorTruncator(
         this->tensorData, *this->tensorAccess);
@@ -95,7 +95,7 @@ public:
 
     this->tensorAccess = new TensorAccess(this->tensorData);
     this->tensorModes = new TensorModes(this->tensorData, *this->tensorAccess);
-    this->tensorOperations = new TensorOperations(*this->tensorModes);
+    this->tensorOperations = new TensorOperations(this->tensorData);
     this->tensorTruncator =
       new TensorTruncator(
         this->tensorData, *this->tensorAccess);
@@ -124,7 +124,7 @@ public:
     this->tensorData = other.tensorData;
     this->tensorAccess = new TensorAccess(this->tensorData);
     this->tensorModes = new TensorModes(this->tensorData, *this->tensorAccess);
-    this->tensorOperations = new TensorOperations(*this->tensorModes);
+    this->tensorOperations = new TensorOperations(this->tensorData);
     this->tensorTruncator =
       new TensorTruncator(
         this->tensorData, *this->tensorAccess);
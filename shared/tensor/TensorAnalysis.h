@@ -26,14 +26,28 @@
 #ifndef __TENSOR_ANALYSIS_H__
 #define __TENSOR_ANALYSIS_H__
 
+#include <algorithm>
+
 #include <armadillo>
 
+#include "tensor/Tensor.h"
+
 class TensorAnalysis{
 
 public:
 
   /*--------------------------------------------------------------------------*/
 
+  // methods for computing the left singular vectors of the unfoldings
+  enum DecompositionMethod{
+    // dense SVD of the unfolded modes
+    SVD,
+    // eigendecomposition of the Gram matrices of the unfoldings
+    GRAM
+  };
+
+  /*--------------------------------------------------------------------------*/
+
   TensorAnalysis(const Tensor& tensor) : originalTensor(tensor) {
 
     this->truncatedModeOneDimension =
@@ -41,11 +55,22 @@ public:
     this->truncatedModeTwoDimension =
       this->coreTensor.data().get_mode_two_dimension();
 
+    this->decompositionMethod = DecompositionMethod::SVD;
+
     this->analysisDone = false;
 
   }
 
 
+  /*--------------------------------------------------------------------------*/
+
+  void set_decomposition_method(const DecompositionMethod& method) {
+
+    this->analysisDone = false;
+    this->decompositionMethod = method;
+
+  }
+
   /*--------------------------------------------------------------------------*/
 
   void set_truncated_mode_one_dimension(const int& dimension) {
@@ -93,6 +118,25 @@ public:
 
   /*--------------------------------------------------------------------------*/
 
+  // left singular vectors and values of A from the Gram matrix A * A^T,
+  // sorted by decreasing singular value
+  static void compute_eigenvectors(
+    const arma::mat& gram, arma::mat& U, arma::vec& S) {
+
+    arma::vec eigenValues;
+    arma::mat eigenVectors;
+
+    arma::eig_sym(eigenValues, eigenVectors, gram);
+
+    U = arma::fliplr(eigenVectors);
+    S = arma::sqrt(arma::clamp(arma::flipud(eigenValues), 0, eigenValues.max()));
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  /*--------------------------------------------------------------------------*/
+
 private:
 
   /*--------------------------------------------------------------------------*/
@@ -115,6 +159,34 @@ private:
 
   void compute_svds() {
 
+    switch(this->decompositionMethod) {
+
+    case DecompositionMethod::SVD:
+      compute_dense_svds();
+      break;
+
+    case DecompositionMethod::GRAM:
+      compute_eigenvectors(
+        compute_mode_one_gram(), this->modeOneU, this->modeOneS);
+      compute_eigenvectors(
+        compute_mode_two_gram(), this->modeTwoU, this->modeTwoS);
+      break;
+
+    }
+
+    // truncate matrices
+    this->modeOneU =
+      this->modeOneU.cols(0, this->truncatedModeOneDimension - 1);
+
+    this->modeTwoU =
+      this->modeTwoU.cols(0, this->truncatedModeTwoDimension - 1);
+
+  } // end compute_svds
+
+  /*--------------------------------------------------------------------------*/
+
+  void compute_dense_svds() {
+
     // unfold the modes
     arma::mat modeOne = this->originalTensor.modes().get_mode_one_matrix();
     arma::mat modeTwo = this->originalTensor.modes().get_mode_two_matrix();
@@ -126,14 +198,74 @@ private:
     arma::svd_econ(this->modeOneU, modeOneS, V, modeOne, "left");
     arma::svd_econ(this->modeTwoU, modeTwoS, V, modeTwo, "left");
 
-    // truncate matrices
-    this->modeOneU =
-      this->modeOneU.cols(0, this->truncatedModeOneDimension - 1);
+  }
 
-    this->modeTwoU =
-      this->modeTwoU.cols(0, this->truncatedModeTwoDimension - 1);
+  /*--------------------------------------------------------------------------*/
 
-  } // end compute_svds
+  // Gram matrix of the mode one unfolding: the raw buffer is its transpose
+  // in column major order, so blocks of rows are accumulated without
+  // unfolding the tensor
+  arma::mat compute_mode_one_gram() {
+
+    TensorData& data = this->originalTensor.data();
+
+    const int modeOneDimension = data.get_mode_one_dimension();
+    const int rows =
+      data.get_mode_two_dimension() * data.get_mode_three_dimension();
+
+    const arma::mat transposed(
+      data.get_data().data(), rows, modeOneDimension, false, true);
+
+    arma::mat gram = arma::zeros(modeOneDimension, modeOneDimension);
+
+    for(int start = 0; start < rows; start += gramBlockSize) {
+
+      const int end = std::min(start + gramBlockSize, rows) - 1;
+      const arma::mat block = transposed.rows(start, end);
+
+      gram += block.t() * block;
+
+    }
+
+    return gram;
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  // Gram matrix of the mode two unfolding: the sum of S^T * S over the
+  // contiguous K x J slices of every speaker
+  arma::mat compute_mode_two_gram() {
+
+    TensorData& data = this->originalTensor.data();
+
+    const int modeOneDimension = data.get_mode_one_dimension();
+    const int modeTwoDimension = data.get_mode_two_dimension();
+    const int modeThreeDimension = data.get_mode_three_dimension();
+
+    arma::mat gram = arma::zeros(modeTwoDimension, modeTwoDimension);
+
+    for(int i = 0; i < modeOneDimension; ++i) {
+
+      const arma::mat slice(
+        data.get_data().data() + i * modeTwoDimension * modeThreeDimension,
+        modeThreeDimension, modeTwoDimension, false, true);
+
+      for(int start = 0; start < modeThreeDimension; start += gramBlockSize) {
+
+        const int end =
+          std::min(start + gramBlockSize, modeThreeDimension) - 1;
+        const arma::mat block = slice.rows(start, end);
+
+        gram += block.t() * block;
+
+      }
+
+    }
+
+    return gram;
+
+  }
 
   /*--------------------------------------------------------------------------*/
 
@@ -177,6 +309,13 @@ private:
   int truncatedModeOneDimension;
   int truncatedModeTwoDimension;
 
+  DecompositionMethod decompositionMethod;
+
+  /*--------------------------------------------------------------------------*/
+
+  // rows of the unfolding accumulated into the Gram matrix at once
+  static const int gramBlockSize = 4096;
+
   /*--------------------------------------------------------------------------*/
 
   bool analysisDone;
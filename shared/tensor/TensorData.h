@@ -27,6 +27,7 @@
 #define __TENSOR_DATA_H__
 
 #include <vector>
+#include <utility>
 
 class TensorData{
 
@@ -54,6 +55,16 @@ public:
 
   /*---------------------------------------------------------------------------*/
 
+  TensorData& set_data( std::vector<double>&& data ) {
+
+    this->data = std::move(data);
+
+    return *this;
+
+  }
+
+  /*---------------------------------------------------------------------------*/
+
   TensorData& set_mode_dimensions(
     const int& modeOne,
     const int& modeTwo,
@@ -27,6 +27,9 @@
 #define __TENSOR_MODES_H__
 
 #include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
 
 #include <armadillo>
 
@@ -50,31 +53,24 @@ public:
   // the mode three unfolding
   std::vector<arma::mat> get_mode_three_matrices_along_mode_one() {
 
-    const int& modeOneDimension = tensorData.get_mode_one_dimension();
-    const int& modeTwoDimension = tensorData.get_mode_two_dimension();
-    const int& modeThreeDimension = tensorData.get_mode_three_dimension();
+    const int modeOneDimension = tensorData.get_mode_one_dimension();
+    const int modeTwoDimension = tensorData.get_mode_two_dimension();
+    const int modeThreeDimension = tensorData.get_mode_three_dimension();
+
+    const double* data = this->tensorData.get_data().data();
+    const int sliceSize = modeTwoDimension * modeThreeDimension;
 
     std::vector<arma::mat> result;
+    result.reserve(modeOneDimension);
 
+    // every slice is a contiguous block of the buffer
     for( int indexModeOne = 0; indexModeOne < modeOneDimension; ++indexModeOne) {
 
-      arma::mat matrix(modeThreeDimension, modeTwoDimension);
-
-      for(int indexModeTwo = 0; indexModeTwo < modeTwoDimension; ++indexModeTwo) {
-
-        for(int indexModeThree = 0;
-            indexModeThree < modeThreeDimension; ++indexModeThree) {
-
-          matrix(indexModeThree, indexModeTwo) =
-            this->tensorAccess.get_entry(
-              indexModeOne, indexModeTwo, indexModeThree
-              );
-
-        } // end for indexModeThree
-
-      } // end for indexModeTwo
-
-      result.push_back(matrix);
+      result.push_back(
+        arma::mat(
+          data + indexModeOne * sliceSize, modeThreeDimension, modeTwoDimension
+          )
+        );
 
     } // end for indexModeOne
 
@@ -87,27 +83,29 @@ public:
   // the mode three unfolding
   std::vector<arma::mat> get_mode_three_matrices_along_mode_two() {
 
-    const int& modeOneDimension = tensorData.get_mode_one_dimension();
-    const int& modeTwoDimension = tensorData.get_mode_two_dimension();
-    const int& modeThreeDimension = tensorData.get_mode_three_dimension();
+    const int modeOneDimension = tensorData.get_mode_one_dimension();
+    const int modeTwoDimension = tensorData.get_mode_two_dimension();
+    const int modeThreeDimension = tensorData.get_mode_three_dimension();
+
+    const double* data = this->tensorData.get_data().data();
+    const int sliceSize = modeTwoDimension * modeThreeDimension;
 
     std::vector<arma::mat> result;
+    result.reserve(modeTwoDimension);
 
     for( int indexModeTwo = 0; indexModeTwo < modeTwoDimension; ++indexModeTwo) {
 
       arma::mat matrix(modeThreeDimension, modeOneDimension);
 
+      // every column is a contiguous run of the buffer
       for(int indexModeOne = 0; indexModeOne < modeOneDimension; ++indexModeOne) {
 
-        for(int indexModeThree = 0;
-            indexModeThree < modeThreeDimension; ++indexModeThree) {
-
-          matrix(indexModeThree, indexModeOne) =
-            this->tensorAccess.get_entry(
-              indexModeOne, indexModeTwo, indexModeThree
-              );
+        const double* source =
+          data + indexModeOne * sliceSize + indexModeTwo * modeThreeDimension;
 
-        } // end for indexModeThree
+        std::copy(
+          source, source + modeThreeDimension, matrix.colptr(indexModeOne)
+          );
 
       } // end for indexModeOne
 
@@ -123,31 +121,17 @@ public:
 
   arma::mat get_mode_one_matrix() {
 
-    const int& modeOneDimension = tensorData.get_mode_one_dimension();
-    const int& modeTwoDimension = tensorData.get_mode_two_dimension();
-    const int& modeThreeDimension = tensorData.get_mode_three_dimension();
-
-    arma::mat matrix(modeOneDimension, modeTwoDimension * modeThreeDimension);
-
-    for(int j = 0; j < modeTwoDimension; ++j) {
-
-      for(int k = 0; k < modeThreeDimension; ++k) {
-
-        const int columnIndex = j * modeThreeDimension + k;
-
-        for(int i = 0; i < modeOneDimension; ++i) {
-
-          const int rowIndex = i;
-
-          matrix(rowIndex, columnIndex) =
-            this->tensorAccess.get_entry(i, j, k);
-
-        } // end i
-      } // end k
-    } // end j
+    const int modeOneDimension = tensorData.get_mode_one_dimension();
+    const int modeTwoDimension = tensorData.get_mode_two_dimension();
+    const int modeThreeDimension = tensorData.get_mode_three_dimension();
 
+    // the buffer is the transposed mode one unfolding in column major order
+    const arma::mat transposed(
+      this->tensorData.get_data().data(),
+      modeTwoDimension * modeThreeDimension, modeOneDimension, false, true
+      );
 
-    return matrix;
+    return transposed.t();
 
   }
 
@@ -155,28 +139,36 @@ public:
 
   arma::mat get_mode_two_matrix() {
 
-    const int& modeOneDimension = tensorData.get_mode_one_dimension();
-    const int& modeTwoDimension = tensorData.get_mode_two_dimension();
-    const int& modeThreeDimension = tensorData.get_mode_three_dimension();
+    const int modeOneDimension = tensorData.get_mode_one_dimension();
+    const int modeTwoDimension = tensorData.get_mode_two_dimension();
+    const int modeThreeDimension = tensorData.get_mode_three_dimension();
 
-    arma::mat matrix(modeTwoDimension, modeOneDimension * modeThreeDimension);
+    double* data = this->tensorData.get_data().data();
+    const int sliceSize = modeTwoDimension * modeThreeDimension;
 
-    for(int k = 0; k < modeThreeDimension; ++k) {
+    arma::mat matrix(modeTwoDimension, modeOneDimension * modeThreeDimension);
+    arma::mat sliceTransposed(modeTwoDimension, modeThreeDimension);
 
-      for(int i = 0; i < modeOneDimension; ++i) {
+    for(int i = 0; i < modeOneDimension; ++i) {
 
-        const int columnIndex = k * modeOneDimension + i;
+      // blocked transpose of the contiguous K x J slice of speaker i
+      const arma::mat slice(
+        data + i * sliceSize,
+        modeThreeDimension, modeTwoDimension, false, true
+        );
 
-        for(int j = 0; j < modeTwoDimension; ++j) {
+      sliceTransposed = slice.t();
 
-          const int rowIndex = j;
+      // scatter the J-runs to the columns k * I + i
+      for(int k = 0; k < modeThreeDimension; ++k) {
 
-          matrix(rowIndex, columnIndex) =
-            this->tensorAccess.get_entry(i, j, k);
+        std::copy(
+          sliceTransposed.colptr(k), sliceTransposed.colptr(k) + modeTwoDimension,
+          matrix.colptr(k * modeOneDimension + i)
+          );
 
-        } // end j
-      } // end i
-    } // end k
+      } // end k
+    } // end i
 
     return matrix;
 
@@ -186,41 +178,25 @@ public:
 
   arma::mat get_mode_three_matrix() {
 
-    const int& modeOneDimension = tensorData.get_mode_one_dimension();
-    const int& modeTwoDimension = tensorData.get_mode_two_dimension();
-    const int& modeThreeDimension = tensorData.get_mode_three_dimension();
-
-    arma::mat matrix(modeThreeDimension, modeOneDimension * modeTwoDimension);
-
-    for(int i = 0; i < modeOneDimension; ++i) {
-      for(int j = 0; j < modeTwoDimension; ++j) {
-
-        const int columnIndex = i * modeTwoDimension + j;
-
-        for(int k = 0; k < modeThreeDimension; ++k) {
+    const int modeOneDimension = tensorData.get_mode_one_dimension();
+    const int modeTwoDimension = tensorData.get_mode_two_dimension();
+    const int modeThreeDimension = tensorData.get_mode_three_dimension();
 
-          const int rowIndex = k;
-
-          matrix(rowIndex, columnIndex) =
-            this->tensorAccess.get_entry(i, j, k);
-
-        } // end k
-      } // end i
-    } // end j
-
-
-    return matrix;
+    // the buffer already is the mode three unfolding in column major order
+    return arma::mat(
+      this->tensorData.get_data().data(),
+      modeThreeDimension, modeOneDimension * modeTwoDimension
+      );
 
   }
 
-
   /*---------------------------------------------------------------------------*/
 
   void unfold_to_mode_one_vectors(const arma::mat& modeOneMatrix) {
 
     int modeOneDimension = tensorData.get_mode_one_dimension();
-    const int& modeTwoDimension = tensorData.get_mode_two_dimension();
-    const int& modeThreeDimension = tensorData.get_mode_three_dimension();
+    const int modeTwoDimension = tensorData.get_mode_two_dimension();
+    const int modeThreeDimension = tensorData.get_mode_three_dimension();
 
     if(
       (int) modeOneMatrix.n_cols > modeTwoDimension * modeThreeDimension ||
@@ -229,26 +205,25 @@ public:
       throw std::runtime_error("Unfolding error: Dimensions too large.");
     }
 
-    modeOneDimension = modeOneMatrix.n_rows;
-
-    std::vector<double> newData;
-
-    for(int i = 0; i < modeOneDimension; ++i) {
-
-      const int rowIndex = i;
+    // every column of the unfolding is read
+    if( (int) modeOneMatrix.n_cols < modeTwoDimension * modeThreeDimension ) {
+      throw std::runtime_error("Unfolding error: Dimensions too small.");
+    }
 
-      for(int j = 0; j < modeTwoDimension; ++j) {
-        for(int k = 0; k < modeThreeDimension; ++k) {
+    modeOneDimension = modeOneMatrix.n_rows;
 
-          const int columnIndex = j * modeThreeDimension + k;
+    std::vector<double> newData(
+      modeOneDimension * modeTwoDimension * modeThreeDimension);
 
-          newData.push_back(modeOneMatrix(rowIndex, columnIndex));
+    // the transposed matrix in column major order is the new buffer
+    arma::mat transposed(
+      newData.data(), modeTwoDimension * modeThreeDimension, modeOneDimension,
+      false, true
+      );
 
-        } // end for k
-      } // end for j
-    } // end for i
+    transposed = modeOneMatrix.t();
 
-    this->tensorData.set_data(newData);
+    this->tensorData.set_data(std::move(newData));
     this->tensorData.set_mode_dimensions(
       modeOneDimension, modeTwoDimension, modeThreeDimension
       );
@@ -259,9 +234,9 @@ public:
 
   void unfold_to_mode_two_vectors(const arma::mat& modeTwoMatrix) {
 
-    const int& modeOneDimension = tensorData.get_mode_one_dimension();
+    const int modeOneDimension = tensorData.get_mode_one_dimension();
     int modeTwoDimension = tensorData.get_mode_two_dimension();
-    const int& modeThreeDimension = tensorData.get_mode_three_dimension();
+    const int modeThreeDimension = tensorData.get_mode_three_dimension();
 
     if(
       (int) modeTwoMatrix.n_cols > modeOneDimension * modeThreeDimension ||
@@ -270,27 +245,40 @@ public:
       throw std::runtime_error("Unfolding error: Dimensions too large.");
     }
 
+    // every column of the unfolding is read
+    if( (int) modeTwoMatrix.n_cols < modeOneDimension * modeThreeDimension ) {
+      throw std::runtime_error("Unfolding error: Dimensions too small.");
+    }
+
     modeTwoDimension = modeTwoMatrix.n_rows;
 
-    std::vector<double> newData;
+    const int sliceSize = modeTwoDimension * modeThreeDimension;
+
+    std::vector<double> newData(modeOneDimension * sliceSize);
+    arma::mat gathered(modeTwoDimension, modeThreeDimension);
 
     for(int i = 0; i < modeOneDimension; ++i) {
 
-      for(int j = 0; j < modeTwoDimension; ++j) {
+      // gather the columns k * I + i into a J x K block
+      for(int k = 0; k < modeThreeDimension; ++k) {
+
+        const double* source = modeTwoMatrix.colptr(k * modeOneDimension + i);
 
-        const int rowIndex = j;
+        std::copy(source, source + modeTwoDimension, gathered.colptr(k));
 
-        for(int k = 0; k < modeThreeDimension; ++k) {
+      } // end for k
 
-          const int columnIndex = k * modeOneDimension + i;
+      // blocked transpose into the K x J slice of speaker i
+      arma::mat slice(
+        newData.data() + i * sliceSize,
+        modeThreeDimension, modeTwoDimension, false, true
+        );
 
-          newData.push_back(modeTwoMatrix(rowIndex, columnIndex));
+      slice = gathered.t();
 
-        } // end for k
-      } // end for j
     } // end for i
 
-    this->tensorData.set_data(newData);
+    this->tensorData.set_data(std::move(newData));
     this->tensorData.set_mode_dimensions(
       modeOneDimension, modeTwoDimension, modeThreeDimension
       );
@@ -301,8 +289,8 @@ public:
 
   void unfold_to_mode_three_vectors(const arma::mat& modeThreeMatrix) {
 
-    const int& modeOneDimension = tensorData.get_mode_one_dimension();
-    const int& modeTwoDimension = tensorData.get_mode_two_dimension();
+    const int modeOneDimension = tensorData.get_mode_one_dimension();
+    const int modeTwoDimension = tensorData.get_mode_two_dimension();
     int modeThreeDimension = tensorData.get_mode_three_dimension();
 
     if(
@@ -312,27 +300,20 @@ public:
       throw std::runtime_error("Unfolding error: Dimensions too large.");
     }
 
-    modeThreeDimension = modeThreeMatrix.n_rows;
-
-    std::vector<double> newData;
-
-    for(int i = 0; i < modeOneDimension; ++i) {
-
-      for(int j = 0; j < modeTwoDimension; ++j) {
-
-        const int columnIndex = i * modeTwoDimension + j;
-
-        for(int k = 0; k < modeThreeDimension; ++k) {
+    // every column of the unfolding is read
+    if( (int) modeThreeMatrix.n_cols < modeOneDimension * modeTwoDimension ) {
+      throw std::runtime_error("Unfolding error: Dimensions too small.");
+    }
 
-          const int rowIndex = k;
+    modeThreeDimension = modeThreeMatrix.n_rows;
 
-          newData.push_back(modeThreeMatrix(rowIndex, columnIndex));
+    // the matrix in column major order is the new buffer
+    const double* source = modeThreeMatrix.memptr();
 
-        } // end for k
-      } // end for j
-    } // end for i
+    std::vector<double> newData(
+      source, source + modeOneDimension * modeTwoDimension * modeThreeDimension);
 
-    this->tensorData.set_data(newData);
+    this->tensorData.set_data(std::move(newData));
     this->tensorData.set_mode_dimensions(
       modeOneDimension, modeTwoDimension, modeThreeDimension
       );
@@ -26,9 +26,13 @@
 #ifndef __TENSOR_OPERATIONS_H__
 #define __TENSOR_OPERATIONS_H__
 
+#include <vector>
+#include <utility>
+#include <stdexcept>
+
 #include <armadillo>
 
-#include "tensor/TensorModes.h"
+#include "tensor/TensorData.h"
 
 class TensorOperations{
 
@@ -36,18 +40,39 @@ public:
 
   /*---------------------------------------------------------------------------*/
 
-  TensorOperations(TensorModes& tensorModes) : tensorModes(tensorModes) {
+  TensorOperations(TensorData& tensorData) : tensorData(tensorData) {
   }
 
   /*---------------------------------------------------------------------------*/
 
   TensorOperations& mode_one_multiply(const arma::mat& matrix) {
 
-    const arma::mat mode_one_matrix = this->tensorModes.get_mode_one_matrix();
+    const int modeOneDimension = this->tensorData.get_mode_one_dimension();
+    const int modeTwoDimension = this->tensorData.get_mode_two_dimension();
+    const int modeThreeDimension = this->tensorData.get_mode_three_dimension();
+
+    check_dimension(matrix, modeOneDimension);
+
+    const int sliceSize = modeTwoDimension * modeThreeDimension;
+    const int resultDimension = matrix.n_rows;
+
+    std::vector<double> result(resultDimension * sliceSize);
 
-    const arma::mat result = matrix * mode_one_matrix;
+    // the buffers are the transposed mode one unfoldings in column major
+    // order: (A * X_(1))^T = X_(1)^T * A^T
+    const arma::mat source(
+      this->tensorData.get_data().data(), sliceSize, modeOneDimension,
+      false, true
+      );
 
-    this->tensorModes.unfold_to_mode_one_vectors(result);
+    arma::mat target(result.data(), sliceSize, resultDimension, false, true);
+
+    target = source * matrix.t();
+
+    this->tensorData.set_data(std::move(result));
+    this->tensorData.set_mode_dimensions(
+      resultDimension, modeTwoDimension, modeThreeDimension
+      );
 
     return *this;
 
@@ -57,11 +82,42 @@ public:
 
   TensorOperations& mode_two_multiply(const arma::mat& matrix) {
 
-    const arma::mat mode_two_matrix = this->tensorModes.get_mode_two_matrix();
+    const int modeOneDimension = this->tensorData.get_mode_one_dimension();
+    const int modeTwoDimension = this->tensorData.get_mode_two_dimension();
+    const int modeThreeDimension = this->tensorData.get_mode_three_dimension();
+
+    check_dimension(matrix, modeTwoDimension);
+
+    const int resultDimension = matrix.n_rows;
+    const int sourceSliceSize = modeTwoDimension * modeThreeDimension;
+    const int targetSliceSize = resultDimension * modeThreeDimension;
+
+    std::vector<double> result(modeOneDimension * targetSliceSize);
+
+    double* data = this->tensorData.get_data().data();
+
+    // every mode one slice is a contiguous K x J matrix that is multiplied
+    // with A^T from the right
+    for(int i = 0; i < modeOneDimension; ++i) {
+
+      const arma::mat source(
+        data + i * sourceSliceSize, modeThreeDimension, modeTwoDimension,
+        false, true
+        );
+
+      arma::mat target(
+        result.data() + i * targetSliceSize, modeThreeDimension, resultDimension,
+        false, true
+        );
 
-    const arma::mat result = matrix * mode_two_matrix;
+      target = source * matrix.t();
 
-    this->tensorModes.unfold_to_mode_two_vectors(result);
+    } // end for i
+
+    this->tensorData.set_data(std::move(result));
+    this->tensorData.set_mode_dimensions(
+      modeOneDimension, resultDimension, modeThreeDimension
+      );
 
     return *this;
 
@@ -71,11 +127,31 @@ public:
 
   TensorOperations& mode_three_multiply(const arma::mat& matrix) {
 
-    const arma::mat mode_three_matrix = this->tensorModes.get_mode_three_matrix();
+    const int modeOneDimension = this->tensorData.get_mode_one_dimension();
+    const int modeTwoDimension = this->tensorData.get_mode_two_dimension();
+    const int modeThreeDimension = this->tensorData.get_mode_three_dimension();
+
+    check_dimension(matrix, modeThreeDimension);
+
+    const int columns = modeOneDimension * modeTwoDimension;
+    const int resultDimension = matrix.n_rows;
+
+    std::vector<double> result(resultDimension * columns);
 
-    const arma::mat result = matrix * mode_three_matrix;
+    // the buffers are the mode three unfoldings in column major order
+    const arma::mat source(
+      this->tensorData.get_data().data(), modeThreeDimension, columns,
+      false, true
+      );
 
-    this->tensorModes.unfold_to_mode_three_vectors(result);
+    arma::mat target(result.data(), resultDimension, columns, false, true);
+
+    target = matrix * source;
+
+    this->tensorData.set_data(std::move(result));
+    this->tensorData.set_mode_dimensions(
+      modeOneDimension, modeTwoDimension, resultDimension
+      );
 
     return *this;
 
@@ -83,12 +159,22 @@ public:
 
   /*---------------------------------------------------------------------------*/
 
-
 private:
 
   /*---------------------------------------------------------------------------*/
 
-  TensorModes& tensorModes;
+  void check_dimension(const arma::mat& matrix, const int& dimension) const {
+
+    if( (int) matrix.n_cols != dimension ) {
+      throw std::runtime_error(
+        "Mode product error: Matrix dimensions do not match tensor.");
+    }
+
+  }
+
+  /*---------------------------------------------------------------------------*/
+
+  TensorData& tensorData;
 
   /*---------------------------------------------------------------------------*/
 
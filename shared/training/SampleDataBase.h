@@ -29,6 +29,7 @@
 #include <unordered_map>
 #include <set>
 #include <string>
+#include <utility>
 
 #include "mesh/Mesh.h"
 
@@ -51,6 +52,19 @@ public:
 
   /*----------------------------------------------------------------------*/
 
+  void add_mesh(
+    Mesh&& mesh,
+    const std::string& speakerId, const std::string& phonemeId) {
+
+    this->speakerIds.insert(speakerId);
+    this->phonemeIds.insert(phonemeId);
+
+    this->database[speakerId][phonemeId] = std::move(mesh);
+
+  }
+
+  /*----------------------------------------------------------------------*/
+
   const Mesh& get_mesh(
     const std::string& speakerId,
     const std::string& phonemeId) const {
@@ -26,6 +26,17 @@
 #ifndef __SAMPLE_FILE_READER_H__
 #define __SAMPLE_FILE_READER_H__
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
 #include <yaml-cpp/yaml.h>
 
 #include "mesh/MeshIO.h"
@@ -38,10 +49,164 @@ public:
 
   /*----------------------------------------------------------------------*/
 
-  static SampleDataBase read_from(const std::string& fileName) {
+  // meshes are parsed by threadAmount workers, at most twice as many parsed
+  // meshes wait for insertion into the database
+  static SampleDataBase read_from(
+    const std::string& fileName,
+    const int& threadAmount = 1,
+    const bool& reportProgress = false) {
+
+    const std::vector<Sample> samples = read_sample_list(fileName);
 
     SampleDataBase database;
 
+    const int sampleAmount = samples.size();
+    const int workerAmount =
+      std::max(1, std::min(threadAmount, sampleAmount));
+    const int capacity = 2 * workerAmount;
+
+    std::mutex mutex;
+    std::condition_variable changed;
+
+    std::deque<Result> results;
+    int nextSample = 0;
+    int inFlight = 0;
+    bool abort = false;
+    std::exception_ptr error = nullptr;
+
+    std::vector<std::thread> workers;
+
+    for(int i = 0; i < workerAmount; ++i) {
+
+      workers.push_back(std::thread([&]() {
+
+            while( true ) {
+
+              int index;
+
+              {
+                std::unique_lock<std::mutex> lock(mutex);
+
+                changed.wait(lock, [&]() {
+                    return abort || inFlight < capacity;
+                  });
+
+                if( abort || nextSample == sampleAmount ) {
+                  return;
+                }
+
+                index = nextSample++;
+                ++inFlight;
+              }
+
+              try {
+
+                const auto start = std::chrono::steady_clock::now();
+
+                Mesh mesh = MeshIO::read(samples.at(index).path);
+
+                const double milliseconds =
+                  std::chrono::duration<double, std::milli>(
+                    std::chrono::steady_clock::now() - start).count();
+
+                std::lock_guard<std::mutex> lock(mutex);
+                results.push_back(Result{index, std::move(mesh), milliseconds});
+
+              }
+              catch(...) {
+
+                std::lock_guard<std::mutex> lock(mutex);
+
+                if( error == nullptr ) {
+                  error = std::current_exception();
+                }
+
+                abort = true;
+
+              }
+
+              changed.notify_all();
+
+            } // end while
+
+          }));
+
+    }
+
+    // insert the meshes in the calling thread
+    for(int received = 0; received < sampleAmount; ++received) {
+
+      Result result;
+
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+
+        changed.wait(lock, [&]() {
+            return abort || !results.empty();
+          });
+
+        if( abort ) {
+          break;
+        }
+
+        result = std::move(results.front());
+        results.pop_front();
+        --inFlight;
+      }
+
+      changed.notify_all();
+
+      const Sample& sample = samples.at(result.index);
+
+      database.add_mesh(
+        std::move(result.mesh), sample.speakerId, sample.phonemeId);
+
+      if( reportProgress == true ) {
+        std::cout << "[" << received + 1 << "/" << sampleAmount << "] "
+                  << sample.path << " read in "
+                  << result.milliseconds << " ms" << '\n';
+      }
+
+    } // end for received
+
+    for(std::thread& worker: workers) {
+      worker.join();
+    }
+
+    if( error != nullptr ) {
+      std::rethrow_exception(error);
+    }
+
+    return database;
+
+  }
+
+  /*----------------------------------------------------------------------*/
+
+private:
+
+  /*----------------------------------------------------------------------*/
+
+  struct Sample{
+    std::string speakerId;
+    std::string phonemeId;
+    std::string path;
+  };
+
+  /*----------------------------------------------------------------------*/
+
+  struct Result{
+    int index;
+    Mesh mesh;
+    double milliseconds;
+  };
+
+  /*----------------------------------------------------------------------*/
+
+  static std::vector<Sample> read_sample_list(const std::string& fileName) {
+
+    std::vector<Sample> samples;
+
     YAML::Node training = YAML::LoadFile(fileName);
 
     // read meshes
@@ -56,14 +221,13 @@ public:
 
         std::string phonemeId = phoneme["prompt"].as<std::string>();
 
-        Mesh mesh = MeshIO::read(phoneme["path"].as<std::string>());
-
-        database.add_mesh(mesh, speakerId, phonemeId);
+        samples.push_back(
+          Sample{speakerId, phonemeId, phoneme["path"].as<std::string>()});
 
       } // end phoneme
     } // end speaker
 
-    return database;
+    return samples;
 
   }
 
@@ -0,0 +1,184 @@
+/****
+   This file is part of the multilinear-model-tools.
+   These tools are meant to derive a multilinear tongue model or
+   PCA palate model from mesh data and work with it.
+
+   Some code of the multilinear-model-tools is based on
+   Timo Bolkart's work on statistical analysis of human face shapes,
+   cf. https://sites.google.com/site/bolkartt/
+
+   Copyright (C) 2016 Alexander Hewer
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+****/
+#ifndef __MAPPED_FILE_H__
+#define __MAPPED_FILE_H__
+
+#include <string>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/* Memory mapped file that is either opened read-only or created with a
+   fixed size for reading and writing */
+class MappedFile{
+
+public:
+
+  /*--------------------------------------------------------------------------*/
+
+  MappedFile() {
+
+    this->address = nullptr;
+    this->length = 0;
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  ~MappedFile() {
+
+    close();
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  /*--------------------------------------------------------------------------*/
+
+  MappedFile& open_read(const std::string& fileName) {
+
+    close();
+
+    const int descriptor = ::open(fileName.c_str(), O_RDONLY);
+
+    if( descriptor < 0 ) {
+      throw std::runtime_error("Could not open file " + fileName + ".");
+    }
+
+    struct stat status;
+
+    if( fstat(descriptor, &status) != 0 ) {
+      ::close(descriptor);
+      throw std::runtime_error("Could not access file " + fileName + ".");
+    }
+
+    map(descriptor, status.st_size, PROT_READ, fileName);
+
+    return *this;
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  MappedFile& create(const std::string& fileName, const size_t& size) {
+
+    close();
+
+    const int descriptor =
+      ::open(fileName.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+
+    if( descriptor < 0 ) {
+      throw std::runtime_error("Could not create file " + fileName + ".");
+    }
+
+    if( ftruncate(descriptor, size) != 0 ) {
+      ::close(descriptor);
+      throw std::runtime_error("Could not resize file " + fileName + ".");
+    }
+
+    map(descriptor, size, PROT_READ | PROT_WRITE, fileName);
+
+    return *this;
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  void close() {
+
+    if( this->address != nullptr ) {
+      munmap(this->address, this->length);
+    }
+
+    this->address = nullptr;
+    this->length = 0;
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  char* data() {
+    return static_cast<char*>(this->address);
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  const char* data() const {
+    return static_cast<const char*>(this->address);
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  size_t size() const {
+    return this->length;
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+private:
+
+  /*--------------------------------------------------------------------------*/
+
+  void map(
+    const int& descriptor, const size_t& size, const int& protection,
+    const std::string& fileName) {
+
+    // empty files can not be mapped
+    if( size == 0 ) {
+      ::close(descriptor);
+      return;
+    }
+
+    void* result = mmap(nullptr, size, protection, MAP_SHARED, descriptor, 0);
+
+    // the mapping stays valid after closing the descriptor
+    ::close(descriptor);
+
+    if( result == MAP_FAILED ) {
+      throw std::runtime_error("Could not map file " + fileName + ".");
+    }
+
+    this->address = result;
+    this->length = size;
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  void* address;
+  size_t length;
+
+  /*--------------------------------------------------------------------------*/
+
+};
+
+#endif
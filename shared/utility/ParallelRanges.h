@@ -0,0 +1,103 @@
+/****
+   This file is part of the multilinear-model-tools.
+   These tools are meant to derive a multilinear tongue model or
+   PCA palate model from mesh data and work with it.
+
+   Some code of the multilinear-model-tools is based on
+   Timo Bolkart's work on statistical analysis of human face shapes,
+   cf. https://sites.google.com/site/bolkartt/
+
+   Copyright (C) 2016 Alexander Hewer
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+****/
+#ifndef __PARALLEL_RANGES_H__
+#define __PARALLEL_RANGES_H__
+
+#include <vector>
+#include <thread>
+#include <exception>
+#include <algorithm>
+
+/* splits index ranges into contiguous parts that are processed by
+   separate threads */
+class ParallelRanges{
+
+public:
+
+  /*--------------------------------------------------------------------------*/
+
+  /* amount of ranges the given amount of elements is split into */
+  static int range_amount(const int& elementAmount, const int& threadAmount) {
+
+    return std::max(1, std::min(threadAmount, elementAmount));
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+  /* splits [0, elementAmount) into contiguous ranges that are processed by
+   * separate threads, process(range, begin, end) is called for every range
+   *
+   * exceptions thrown while processing are rethrown in the calling thread
+   */
+  template<typename Function>
+  static void process_ranges(
+    const int& elementAmount,
+    const int& rangeAmount,
+    Function process) {
+
+    if( rangeAmount == 1 ) {
+      process(0, 0, elementAmount);
+      return;
+    }
+
+    std::vector<std::exception_ptr> errors(rangeAmount);
+    std::vector<std::thread> threads;
+
+    for(int i = 0; i < rangeAmount; ++i) {
+
+      const int begin = ( (long) elementAmount * i ) / rangeAmount;
+      const int end = ( (long) elementAmount * ( i + 1 ) ) / rangeAmount;
+
+      threads.push_back(std::thread([=, &process, &errors]() {
+
+            try {
+              process(i, begin, end);
+            }
+            catch(...) {
+              errors.at(i) = std::current_exception();
+            }
+
+          }));
+
+    }
+
+    for(std::thread& thread: threads) {
+      thread.join();
+    }
+
+    for(const std::exception_ptr& error: errors) {
+      if( error != nullptr ) {
+        std::rethrow_exception(error);
+      }
+    }
+
+  }
+
+  /*--------------------------------------------------------------------------*/
+
+};
+#endif
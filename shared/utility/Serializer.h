@@ -30,6 +30,8 @@
 
 #include <armadillo>
 
+#include "mesh/PointList.h"
+
 class Serializer{
 
 public:
@@ -56,24 +58,18 @@ public:
 
   /*--------------------------------------------------------------------------*/
 
-  static std::vector<arma::vec> unserialize(const arma::vec& serialized) {
-
-    const size_t amount = serialized.n_elem / 3;
-    std::vector<arma::vec> result;
+  /* the point list already stores the serialized layout */
+  static arma::vec serialize(const PointList& points) {
 
-    for(size_t i = 0; i < amount; ++i) {
+    return arma::vec(points.data(), 3 * points.size());
 
-      arma::vec point = arma::zeros(3);
-
-      point(0) = serialized(i * 3 + 0);
-      point(1) = serialized(i * 3 + 1);
-      point(2) = serialized(i * 3 + 2);
+  }
 
-      result.push_back(point);
+  /*--------------------------------------------------------------------------*/
 
-    }
+  static PointList unserialize(const arma::vec& serialized) {
 
-    return result;
+    return PointList(serialized);
 
   }
 